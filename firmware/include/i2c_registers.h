@@ -21,6 +21,7 @@
 // ============================================================================
 #define I2C_SLAVE_ADDRESS     0x42  // 7-bit I2C address
 #define I2C_BUFFER_SIZE       32    // Maximum I2C transaction size
+#define I2C_BUS_SPEED_HZ      1000000  // Fast-mode plus; slave tracks the master clock
 
 // ============================================================================
 // REGISTER MAP
@@ -51,6 +52,16 @@
 #define REG_TAPE_DIRECTION    0x41  // Tape motor direction (R/W)
 #define REG_TAPE_MODE         0x42  // Tape motor mode (R/W)
 
+// Virtual tape counter: the firmware integrates the actual (ramped) drive
+// speed into a signed 32-bit odometer at the 100Hz tick, so the displayed
+// count no longer drifts when the host misses updates. Little-endian;
+// reverse drive decrements. Reset with CMD_RESET_ODOMETER. Read the
+// latched copy at REG_SNAPSHOT_ODO_0 for a tear-free 32-bit value.
+#define REG_TAPE_ODO_0        0x43  // Odometer byte 0 (LSB) (R)
+#define REG_TAPE_ODO_1        0x44  // Odometer byte 1 (R)
+#define REG_TAPE_ODO_2        0x45  // Odometer byte 2 (R)
+#define REG_TAPE_ODO_3        0x46  // Odometer byte 3 (MSB) (R)
+
 // --- Digital Inputs (Read-Only) ---
 #define REG_INPUT_STATUS_LOW  0x50  // Digital inputs 1-8 status (R)
 #define REG_INPUT_STATUS_HIGH 0x51  // Digital inputs 9-12 status (R)
@@ -65,8 +76,115 @@
 
 // --- Configuration Registers ---
 #define REG_CONFIG_VU_FREQ    0x70  // VU meter PWM frequency (R/W)
-#define REG_CONFIG_DEBOUNCE   0x71  // Input debounce time (R/W)
+#define REG_CONFIG_DEBOUNCE   0x71  // Input debounce time, ms, 40ms steps (R/W)
 #define REG_CONFIG_OPTIONS    0x72  // Configuration options (R/W)
+#define REG_CONFIG_VU_ATTACK  0x73  // VU attack time, 10ms units, 0=instant (R/W)
+#define REG_CONFIG_VU_RELEASE 0x74  // VU release time, 10ms units, 0=instant (R/W)
+#define REG_CONFIG_PEAK_HOLD  0x75  // Peak hold time, 10ms units (R/W)
+#define REG_CONFIG_PEAK_DECAY 0x76  // Peak decay rate, counts per 10ms tick (R/W)
+#define REG_CONFIG_VU_SLEW    0x77  // VU slew limit, 1/4 counts per 1ms tick, 0=instant (R/W)
+#define REG_CONFIG_TAPE_ACCEL 0x78  // Tape motor ramp rate, counts per 10ms tick, 0=instant (R/W)
+#define REG_CONFIG_LOG_LEVEL  0x79  // Serial log levels, 2 bits per category (R/W)
+#define REG_CONFIG_IDLE_TIMEOUT 0x7A // Backlight idle dim timeout, seconds, 0=disabled (R/W)
+#define REG_CONFIG_IDLE_LEVEL 0x7B  // Backlight brightness while idle-dimmed (R/W)
+#define REG_CONFIG_HOST_TIMEOUT 0x7C // Host liveness window, 100ms units, 0=disabled (R/W)
+
+// --- State Snapshot (Read-Only, latched once per update tick) ---
+// The entire block is copied atomically from the live registers at the end
+// of each 100Hz update cycle, so a single multi-byte burst read starting at
+// REG_SNAPSHOT_BASE always returns a coherent view of the machine state.
+#define REG_SNAPSHOT_BASE         0x80  // Start of snapshot block
+#define REG_SNAPSHOT_STATUS       0x80  // Latched status register (R)
+#define REG_SNAPSHOT_ERROR        0x81  // Latched error register (R)
+#define REG_SNAPSHOT_INPUT_LOW    0x82  // Latched inputs 1-8 status (R)
+#define REG_SNAPSHOT_INPUT_HIGH   0x83  // Latched inputs 9-12 status (R)
+#define REG_SNAPSHOT_CHANGED_LOW  0x84  // Latched inputs 1-8 changed flags (R, clears on read)
+#define REG_SNAPSHOT_CHANGED_HIGH 0x85  // Latched inputs 9-12 changed flags (R, clears on read)
+#define REG_SNAPSHOT_ENC_POS_LOW  0x86  // Latched encoder position low byte (R)
+#define REG_SNAPSHOT_ENC_POS_HIGH 0x87  // Latched encoder position high byte (R)
+#define REG_SNAPSHOT_ENC_DELTA    0x88  // Latched encoder delta (R, clears on read)
+#define REG_SNAPSHOT_ENC_BUTTON   0x89  // Latched encoder button status (R)
+#define REG_SNAPSHOT_TICK_LOW     0x8A  // Update tick counter low byte (R)
+#define REG_SNAPSHOT_TICK_HIGH    0x8B  // Update tick counter high byte (R)
+#define REG_SNAPSHOT_ODO_0        0x8C  // Latched tape odometer byte 0 (LSB) (R)
+#define REG_SNAPSHOT_ODO_1        0x8D  // Latched tape odometer byte 1 (R)
+#define REG_SNAPSHOT_ODO_2        0x8E  // Latched tape odometer byte 2 (R)
+#define REG_SNAPSHOT_ODO_3        0x8F  // Latched tape odometer byte 3 (MSB) (R)
+#define REG_SNAPSHOT_END          0x9F  // End of snapshot block
+#define SNAPSHOT_SIZE             16    // Number of valid snapshot bytes
+
+// --- VU Sample FIFO (firmware-timed playback) ---
+// The host bursts frames of (left, right, hold_ms) bytes into the data port;
+// the firmware plays them back on its own 100Hz timebase, applying each frame
+// to the raw VU levels after the previous frame's hold time elapses. This
+// decouples needle timing from host I2C scheduling jitter.
+#define REG_VU_FIFO_DATA      0xA0  // Frame data port, 3 bytes/frame (W, no auto-increment)
+#define REG_VU_FIFO_COUNT     0xA1  // Complete frames queued (R)
+#define REG_VU_FIFO_SPACE     0xA2  // Free frame slots (R)
+
+// --- Paired VU Write ---
+// One block write of (left, right) to this port stages both channel levels
+// into shadow registers; the control loop latches them into VU_LEFT and
+// VU_RIGHT together at the next 100Hz tick, so the needles move in
+// lockstep on stereo transients instead of left leading right by a tick.
+// Halves the transaction count versus two single-register writes.
+#define REG_VU_PAIR_DATA      0xA3  // Pair port, 2 bytes: left, right (W, no auto-increment)
+#define VU_FIFO_DEPTH         32    // Frame capacity of the FIFO
+#define VU_FIFO_FRAME_SIZE    3     // Bytes per frame: left, right, hold_ms
+
+// --- Input/Encoder Event Queue ---
+// Every input edge, encoder movement and button transition is queued as a
+// 4-byte timestamped event: type, data, timestamp low, timestamp high (ms,
+// wraps at 16 bits). The host reads EVENT_FIFO_COUNT, then bursts count*4
+// bytes from the data port in one transaction - no edge is ever lost to a
+// missed poll, and timestamps come from the firmware clock.
+#define REG_EVENT_FIFO_DATA   0xA8  // Event byte stream (R, no auto-increment)
+#define REG_EVENT_FIFO_COUNT  0xA9  // Complete events queued (R)
+#define EVENT_FIFO_DEPTH      32    // Event capacity of the queue
+#define EVENT_SIZE            4     // Bytes per event
+
+// --- Animation Engine Status (Read-Only) ---
+// The CMD_TEST_* command currently being animated, CMD_NOP (0x00) when the
+// engine is idle. Poll after issuing a test pattern to detect completion.
+#define REG_ANIM_ACTIVE       0xAA  // Running test pattern, 0=idle (R)
+
+// --- Performance Counters (Read-Only) ---
+// Live instrumentation of the control loop and I2C service, all times in
+// microseconds (16-bit values little-endian). The MAX registers latch the
+// worst case observed and reset when their high byte is read.
+#define REG_PERF_TICK_US_LOW    0xB0  // Last control tick duration low byte (R)
+#define REG_PERF_TICK_US_HIGH   0xB1  // Last control tick duration high byte (R)
+#define REG_PERF_TICK_MAX_LOW   0xB2  // Max tick duration low byte (R)
+#define REG_PERF_TICK_MAX_HIGH  0xB3  // Max tick duration high byte (R, clears max)
+#define REG_PERF_JITTER_US_LOW  0xB4  // Last tick-interval jitter low byte (R)
+#define REG_PERF_JITTER_US_HIGH 0xB5  // Last tick-interval jitter high byte (R)
+#define REG_PERF_JITTER_MAX_LOW 0xB6  // Max jitter low byte (R)
+#define REG_PERF_JITTER_MAX_HIGH 0xB7 // Max jitter high byte (R, clears max)
+#define REG_PERF_I2C_US         0xB8  // Last I2C handler duration (R)
+#define REG_PERF_I2C_MAX        0xB9  // Max I2C handler duration (R, clears max)
+
+// --- Benchmark Results (Read-Only, written by CMD_BENCHMARK) ---
+// The benchmark runs on core1 in place of one control tick and measures
+// what this build can sustain: the register write path, a full control
+// cycle (input scan, encoder, PWM update), and the headroom left in the
+// 10ms tick budget.
+#define REG_BENCH_WRITE_KOPS_LOW  0xBA  // i2c_register_write throughput low byte (kops/s) (R)
+#define REG_BENCH_WRITE_KOPS_HIGH 0xBB  // i2c_register_write throughput high byte (R)
+#define REG_BENCH_CYCLE_US_LOW    0xBC  // Full control cycle duration low byte (us) (R)
+#define REG_BENCH_CYCLE_US_HIGH   0xBD  // Full control cycle duration high byte (R)
+#define REG_BENCH_HEADROOM        0xBE  // Tick budget left after a control cycle (%) (R)
+#define REG_BENCH_STATUS          0xBF  // 0=no results, 1=running, 2=done (R)
+
+#define BENCH_IDLE            0x00
+#define BENCH_RUNNING         0x01
+#define BENCH_DONE            0x02
+
+// Event types
+#define EVENT_NONE            0x00  // Queue empty (reads as all zeros)
+#define EVENT_INPUT_PRESS     0x01  // Digital input pressed (data = input 1-12)
+#define EVENT_INPUT_RELEASE   0x02  // Digital input released (data = input 1-12)
+#define EVENT_ENCODER_DELTA   0x03  // Encoder moved (data = signed delta)
+#define EVENT_BUTTON          0x04  // Button transition (data = new ENC_BTN_* state)
 
 // --- Command Register (Write-Only) ---
 #define REG_COMMAND           0xF0  // Command register (W)
@@ -101,8 +219,8 @@
 #define ERROR_INVALID_CMD     (1 << 2)  // Invalid command
 #define ERROR_PWM_FAULT       (1 << 3)  // PWM generation fault
 #define ERROR_WATCHDOG        (1 << 4)  // Watchdog timeout
-#define ERROR_RESERVED_5      (1 << 5)  // Reserved
-#define ERROR_RESERVED_6      (1 << 6)  // Reserved
+#define ERROR_EVENT_OVERFLOW  (1 << 5)  // Event queue overflow (incoming event dropped)
+#define ERROR_HOST_TIMEOUT    (1 << 6)  // Host went silent; outputs were parked
 #define ERROR_RESERVED_7      (1 << 7)  // Reserved
 
 // REG_VU_MODE (0x22) - VU Meter Mode
@@ -128,6 +246,61 @@
 #define TAPE_MODE_AUTO        0x01      // Auto speed based on playback
 #define TAPE_MODE_OFF         0xFF      // Motor off
 
+// REG_CONFIG_VU_ATTACK/RELEASE (0x73-0x74) - VU Ballistics Time Constants
+// Time for the needle to reach 99% of a step, in 10ms units (ANSI C16.5
+// specifies 300ms, i.e. a register value of 30). 0 disables the filter.
+#define VU_BALLISTICS_DEFAULT 30        // 300ms per ANSI C16.5-1942
+
+// REG_CONFIG_PEAK_HOLD/DECAY (0x75-0x76) - Peak Hold Behavior
+// In VU_MODE_PEAK_HOLD the needle latches at the peak level, holds for
+// PEAK_HOLD 10ms units, then falls PEAK_DECAY counts per 10ms tick.
+#define PEAK_HOLD_DEFAULT     100       // 1s hold
+#define PEAK_DECAY_DEFAULT    4         // Full scale decays in ~640ms
+
+// REG_CONFIG_VU_SLEW (0x77) - VU Output Slew Limit
+// Maximum needle travel per 1ms scheduler tick, in 1/4 count units. The
+// slew stage interpolates the 100Hz ballistics output at 1kHz so needle
+// motion stays smooth regardless of the host update rate. 0 = instant.
+#define VU_SLEW_DEFAULT       16        // 4 counts/ms, full scale in 64ms
+
+// REG_CONFIG_TAPE_ACCEL (0x78) - Tape Motor Ramp Rate
+// TAPE_SPEED and TAPE_DIRECTION writes set targets; the tick loop ramps
+// the H-bridge duty toward them at this rate. Direction changes (including
+// into BRAKE) ramp down through zero first. 0 applies writes instantly.
+#define TAPE_ACCEL_DEFAULT    8         // 0 to full speed in ~320ms
+
+// REG_CONFIG_LOG_LEVEL (0x79) - Serial Log Levels
+// Two bits per category select how much each subsystem traces to the USB
+// console. Messages are only formatted while a console is attached, so
+// verbose levels cost nothing on a headless unit.
+#define LOG_CAT_SYS           0         // Boot, commands, benchmark
+#define LOG_CAT_I2C           1         // Protocol errors
+#define LOG_CAT_CTRL          2         // Control loop, animations
+#define LOG_CAT_CONFIG        3         // Flash config journal
+#define LOG_OFF               0x00
+#define LOG_ERROR             0x01
+#define LOG_INFO              0x02
+#define LOG_DEBUG             0x03
+#define LOG_LEVEL_DEFAULT     0xAA      // INFO for all four categories
+
+// REG_CONFIG_IDLE_TIMEOUT (0x7A) / REG_CONFIG_IDLE_LEVEL (0x7B)
+// Firmware idle dimming: after IDLE_TIMEOUT seconds with no input edge,
+// encoder motion or button press, the backlight ramps down to IDLE_LEVEL;
+// any user activity restores full brightness on the next 10ms tick. The
+// dim level caps whatever the active backlight mode produces, so it never
+// raises a brightness the host set lower. 0 timeout disables the engine
+// (host-driven dimming as before).
+#define IDLE_TIMEOUT_DEFAULT  0         // Disabled until the host opts in
+#define IDLE_LEVEL_DEFAULT    0         // Dim fully off
+
+// REG_CONFIG_HOST_TIMEOUT (0x7C) - Host Liveness Window
+// If no I2C transaction arrives for this many 100ms units, the firmware
+// parks the outputs: VU targets drop to zero (the slew engine glides the
+// needles down) and the tape motor ramps to a stop. ERROR_HOST_TIMEOUT
+// latches to record the event. The next host transaction restores normal
+// operation within one 10ms tick - no reboot involved. 0 disables.
+#define HOST_TIMEOUT_DEFAULT  0         // Disabled until the host opts in
+
 // REG_ENCODER_BUTTON (0x63) - Encoder Button Status
 #define ENC_BTN_RELEASED      0x00      // Button released
 #define ENC_BTN_PRESSED       0x01      // Button pressed
@@ -144,8 +317,11 @@
 #define CMD_TEST_VU_LEFT      0x11  // Test left VU meter (sweep)
 #define CMD_TEST_VU_RIGHT     0x12  // Test right VU meter (sweep)
 #define CMD_TEST_VU_BOTH      0x13  // Test both VU meters
+#define CMD_VU_FIFO_FLUSH     0x14  // Discard all queued VU FIFO frames
 #define CMD_TEST_BACKLIGHT    0x20  // Test backlight (fade in/out)
 #define CMD_TEST_TAPE_MOTOR   0x30  // Test tape motor
+#define CMD_RESET_ODOMETER    0x31  // Zero the virtual tape counter odometer
+#define CMD_BENCHMARK         0x40  // Run internal benchmark, results in 0xBA-0xBE
 #define CMD_TEST_ALL          0xFF  // Test all outputs
 
 // ============================================================================
@@ -194,7 +370,11 @@ typedef struct {
     uint8_t tape_speed;             // 0x40
     uint8_t tape_direction;         // 0x41
     uint8_t tape_mode;              // 0x42
-    uint8_t reserved_43[13];        // 0x43-0x4F
+    uint8_t tape_odo_0;             // 0x43 (odometer LSB)
+    uint8_t tape_odo_1;             // 0x44
+    uint8_t tape_odo_2;             // 0x45
+    uint8_t tape_odo_3;             // 0x46 (odometer MSB)
+    uint8_t reserved_47[9];         // 0x47-0x4F
 
     // Digital Inputs
     uint8_t input_status_low;       // 0x50 (bits 0-7 = inputs 1-8)
@@ -214,7 +394,66 @@ typedef struct {
     uint8_t config_vu_freq;         // 0x70
     uint8_t config_debounce;        // 0x71
     uint8_t config_options;         // 0x72
-    uint8_t reserved_73[13];        // 0x73-0x7F
+    uint8_t config_vu_attack;       // 0x73
+    uint8_t config_vu_release;      // 0x74
+    uint8_t config_peak_hold;       // 0x75
+    uint8_t config_peak_decay;      // 0x76
+    uint8_t config_vu_slew;         // 0x77
+    uint8_t config_tape_accel;      // 0x78
+    uint8_t config_log_level;       // 0x79
+    uint8_t config_idle_timeout;    // 0x7A
+    uint8_t config_idle_level;      // 0x7B
+    uint8_t config_host_timeout;    // 0x7C
+    uint8_t reserved_7D[3];         // 0x7D-0x7F
+
+    // State Snapshot (latched once per update tick)
+    uint8_t snap_status;            // 0x80
+    uint8_t snap_error;             // 0x81
+    uint8_t snap_input_status_low;  // 0x82
+    uint8_t snap_input_status_high; // 0x83
+    uint8_t snap_input_changed_low; // 0x84
+    uint8_t snap_input_changed_high; // 0x85
+    uint8_t snap_encoder_pos_low;   // 0x86
+    uint8_t snap_encoder_pos_high;  // 0x87
+    int8_t  snap_encoder_delta;     // 0x88 (signed)
+    uint8_t snap_encoder_button;    // 0x89
+    uint8_t snap_tick_low;          // 0x8A
+    uint8_t snap_tick_high;         // 0x8B
+    uint8_t snap_odo_0;             // 0x8C (latched odometer LSB)
+    uint8_t snap_odo_1;             // 0x8D
+    uint8_t snap_odo_2;             // 0x8E
+    uint8_t snap_odo_3;             // 0x8F (latched odometer MSB)
+    uint8_t reserved_90[16];        // 0x90-0x9F
+
+    // VU Sample FIFO
+    uint8_t vu_fifo_data;           // 0xA0 (write port, reads as 0)
+    uint8_t vu_fifo_count;          // 0xA1
+    uint8_t vu_fifo_space;          // 0xA2
+    uint8_t reserved_A3[5];         // 0xA3-0xA7 (0xA3 = pair port, bypasses the bank)
+
+    // Input/Encoder Event Queue
+    uint8_t event_fifo_data;        // 0xA8 (read port, streamed from the queue)
+    uint8_t event_fifo_count;       // 0xA9
+    uint8_t anim_active;            // 0xAA
+    uint8_t reserved_AB[5];         // 0xAB-0xAF
+
+    // Performance Counters
+    uint8_t perf_tick_us_low;       // 0xB0
+    uint8_t perf_tick_us_high;      // 0xB1
+    uint8_t perf_tick_max_low;      // 0xB2
+    uint8_t perf_tick_max_high;     // 0xB3
+    uint8_t perf_jitter_us_low;     // 0xB4
+    uint8_t perf_jitter_us_high;    // 0xB5
+    uint8_t perf_jitter_max_low;    // 0xB6
+    uint8_t perf_jitter_max_high;   // 0xB7
+    uint8_t perf_i2c_us;            // 0xB8
+    uint8_t perf_i2c_max;           // 0xB9
+    uint8_t bench_write_kops_low;   // 0xBA
+    uint8_t bench_write_kops_high;  // 0xBB
+    uint8_t bench_cycle_us_low;     // 0xBC
+    uint8_t bench_cycle_us_high;    // 0xBD
+    uint8_t bench_headroom;         // 0xBE
+    uint8_t bench_status;           // 0xBF
 } __attribute__((packed)) I2CRegisterBank;
 
 // ============================================================================
@@ -248,6 +487,11 @@ bool i2c_register_write(uint8_t reg_addr, uint8_t value);
  */
 bool i2c_execute_command(uint8_t command);
 
+/**
+ * @brief Latch the state snapshot block from the live registers
+ */
+void i2c_update_snapshot(void);
+
 /**
  * @brief Update register bank from hardware state
  */
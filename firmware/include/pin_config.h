@@ -38,6 +38,17 @@
 #define VU_PWM_FREQUENCY      1000 // 1kHz PWM frequency
 #define VU_PWM_RESOLUTION     255  // 8-bit resolution (0-255)
 
+// Direct slice programming (see setup_pwm): the backlight and tape slices
+// run a 10-bit counter so 1kHz is reachable within the 8.4-bit clock
+// divider limit; 8-bit register levels are scaled up when written
+#define PWM_COUNTER_WRAP      1023
+
+// The VU slices run a 12-bit counter so the bottom of the needle scale
+// gets fine quantization; the carrier is set by REG_CONFIG_VU_FREQ in
+// kHz (12 bits at 133MHz allows up to ~32kHz, above coil audibility)
+#define VU_PWM_WRAP           4095
+#define VU_PWM_FREQ_MAX_KHZ   32
+
 // ============================================================================
 // PANEL BACKLIGHT - PWM OUTPUT (DRV8822 Motor Driver)
 // ============================================================================
@@ -67,6 +78,7 @@
 
 // Encoder Configuration
 #define ENCODER_DEBOUNCE_MS   5    // Debounce time in milliseconds
+#define ENCODER_PIO_SAMPLE_HZ 10000 // PIO quadrature sampling rate (also filters contact bounce)
 
 // ============================================================================
 // DIGITAL INPUTS (12 channels)
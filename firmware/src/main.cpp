@@ -6,6 +6,7 @@
  * for a music streamer based on PiCorePlayer and RPi Zero 2.
  *
  * Features:
+ * - Dual-core: I2C slave service on core0, control loop on core1
  * - I2C slave interface (address 0x42)
  * - 2x VU meter control via PWM (DRV8833)
  * - Panel backlight control via PWM (DRV8822)
@@ -19,6 +20,15 @@
 
 #include <Arduino.h>
 #include <Wire.h>
+#include <stdarg.h>
+#include "hardware/flash.h"
+#include "hardware/gpio.h"
+#include "hardware/pio.h"
+#include "hardware/pwm.h"
+#include "hardware/sync.h"
+#include "hardware/watchdog.h"
+#include "pico/platform.h"
+#include "pico/time.h"
 #include "pin_config.h"
 #include "i2c_registers.h"
 
@@ -27,87 +37,504 @@
 // ============================================================================
 
 // I2C Register Bank
+//
+// Concurrency model: core1 owns the live state registers (inputs, encoder,
+// status bits, FIFO playback) and publishes each tick through state_seq, a
+// seqlock sequence counter - odd while a tick is mutating state, even when
+// the bank is quiescent. Core0 owns the snapshot block, the config block
+// and host write dispatch; its snapshot latch retries until it copies
+// between two equal even sequence reads, so it can never publish torn
+// state no matter how the two cores interleave. Host actions that touch
+// core1-owned state (encoder reset, input-change clear) are staged as
+// flags and applied by core1 at its next tick boundary. Both cores are
+// in-order M0+ with uncached SRAM, so the volatile counter is sufficient
+// ordering.
 I2CRegisterBank registers;
 
+volatile uint32_t state_seq = 0;                 // Seqlock counter (core1 publishes)
+volatile bool encoder_reset_pending = false;     // CTRL_RESET_ENCODER staged for core1
+volatile bool input_clear_pending = false;       // CTRL_CLEAR_INPUTS staged for core1
+volatile uint8_t changed_low_ack_mask = 0;       // Clear-on-read bits staged for core1
+volatile uint8_t changed_high_ack_mask = 0;
+volatile bool encoder_ack_pending = false;       // Delta read acknowledge
+volatile bool odometer_reset_pending = false;    // CMD_RESET_ODOMETER staged for core1
+
 // Current register pointer for I2C reads
 volatile uint8_t current_register = 0;
 
-// Digital input state tracking
-uint8_t input_state_low = 0xFF;
-uint8_t input_state_high = 0x0F;
-uint8_t input_prev_low = 0xFF;
-uint8_t input_prev_high = 0x0F;
-uint32_t input_last_change[NUM_DIGITAL_INPUTS] = {0};
+// Prefetched read response window. Staged at address-write time so the
+// per-byte request ISR is a plain buffer fetch - at 1MHz Fm+ a byte slot is
+// ~9us and there is no time to walk the register dispatch in the ISR.
+#define I2C_TX_WINDOW_SIZE 16
+uint8_t i2c_tx_window[I2C_TX_WINDOW_SIZE];
+uint8_t i2c_tx_len = 0;     // Staged bytes (0 = nothing staged)
+uint8_t i2c_tx_idx = 0;     // Next staged byte to send
+
+// Write burst mailbox. The receive ISR only copies the transaction here;
+// dispatch through i2c_register_write() happens once, from core0's idle
+// loop, so a 32-byte burst no longer walks the register dispatch with the
+// bus interrupt asserted. The ISRs flush inline only when ordering
+// requires it (back-to-back transactions before the idle loop ran).
+uint8_t i2c_rx_mailbox[I2C_BUFFER_SIZE];
+uint8_t i2c_rx_reg = 0;                  // First register of the pending burst
+volatile uint8_t i2c_rx_count = 0;       // Pending bytes (0 = mailbox empty)
+
+// Digital input state tracking (bit i = input i+1, 1 = released)
+// Debounced with 2-bit vertical counters: all 12 inputs advance in parallel
+// and a change commits after 4 consecutive differing samples. The counters
+// advance every input_debounce_stride ticks, derived from CONFIG_DEBOUNCE,
+// so the window is 4 * stride * 10ms (40ms granularity).
+uint16_t input_debounced = 0x0FFF;
+uint16_t input_vcount0 = 0;
+uint16_t input_vcount1 = 0;
+uint8_t input_debounce_cfg_cached = INPUT_DEBOUNCE_MS;
+uint8_t input_debounce_stride = 1;   // Ticks between counter advances
+uint8_t input_debounce_phase = 0;
 
 // Encoder state tracking
 volatile int16_t encoder_position = 0;
-volatile int8_t encoder_delta = 0;
-volatile uint8_t encoder_state = 0;
+uint8_t encoder_state = 0;
 uint8_t encoder_button_state = ENC_BTN_RELEASED;
 uint32_t encoder_button_press_time = 0;
 uint32_t encoder_button_last_release = 0;
 
+// PIO quadrature decoder
+// The state machine samples GP10/GP11 at ENCODER_PIO_SAMPLE_HZ and pushes
+// the 2-bit pin state to its RX FIFO on every change; the main loop drains
+// the FIFO and applies the quadrature transition table. No GPIO interrupts,
+// no critical sections, no missed steps at any rotation speed.
+PIO encoder_pio = pio0;
+int encoder_pio_sm = -1;
+
+// PIO program (hand-assembled, see comments for the .pio source):
+//     .wrap_target
+//     mov isr, null        ; clear ISR
+//     in pins, 2           ; sample encoder A/B
+//     mov x, isr
+//     jmp x != y, notify   ; state changed?
+//     jmp 0                ; no - sample again
+// notify:
+//     push noblock         ; report new state to the CPU
+//     mov y, x             ; remember it
+//     jmp 0
+//     .wrap
+static const uint16_t encoder_pio_instructions[] = {
+    0xA0C3,  // mov isr, null
+    0x4002,  // in pins, 2
+    0xA026,  // mov x, isr
+    0x00A5,  // jmp x != y, 5
+    0x0000,  // jmp 0
+    0x8000,  // push noblock
+    0xA041,  // mov y, x
+    0x0000,  // jmp 0
+};
+
+static const pio_program_t encoder_pio_program = {
+    encoder_pio_instructions,
+    sizeof(encoder_pio_instructions) / sizeof(encoder_pio_instructions[0]),
+    -1,  // no fixed origin (jmp targets are relocated on load)
+};
+
 // PWM slices for each output
 uint slice_vu_left, slice_vu_right;
 uint slice_backlight;
 uint slice_tape_motor;
 
+// Last duty written to each GPIO, so idle outputs are not reprogrammed
+// every tick (0xFFFF = never written, forces the first write through)
+uint16_t pwm_last_level[30];
+
 // Status LED blink state
 uint32_t led_last_blink = 0;
 bool led_state = false;
 
+// Update tick counter (increments once per 100Hz cycle, wraps at 16 bits)
+uint16_t update_tick = 0;
+
+// 1kHz hardware-timer scheduler (core1)
+// A repeating alarm increments the tick counter from IRQ context; loop1()
+// sleeps in WFE until the counter advances instead of polling millis() with
+// a delay(1) in between. The control tasks run on every 10th tick (100Hz).
+#define SCHEDULER_TICK_HZ        1000
+#define SCHEDULER_TICKS_PER_UPDATE 10
+volatile uint32_t scheduler_ticks = 0;
+repeating_timer_t scheduler_timer;
+alarm_pool_t *core1_alarm_pool = NULL;
+
+// Performance counters (worst-case values latched until read by the host)
+uint16_t perf_tick_max_us = 0;
+uint16_t perf_jitter_max_us = 0;
+volatile uint8_t perf_i2c_max_us = 0;
+
+// Test animation engine (CMD_TEST_*): patterns advance one step per 100Hz
+// tick instead of blocking, so I2C and the control loop stay live
+volatile uint8_t anim_active = CMD_NOP;   // Command being animated (CMD_NOP = idle)
+uint16_t anim_step = 0;
+uint8_t anim_saved_vu_left = 0;           // Register values to restore when done
+uint8_t anim_saved_vu_right = 0;
+uint8_t anim_saved_backlight = 0;
+uint8_t anim_saved_tape_speed = 0;
+uint8_t anim_saved_tape_direction = 0;
+
+// Backlight effect state. The gamma LUT linearizes perceived brightness so
+// AUTO and PULSE don't band at the low end; filled once in setup_backlight().
+uint8_t backlight_gamma_lut[256];
+uint16_t backlight_auto_level_q8 = 0;   // EMA of the VU level (Q8.8)
+uint16_t backlight_pulse_phase = 0;     // Triangle phase, 512 steps per cycle
+
+// Idle dimming engine: ticks since the last user input and the brightness
+// ceiling it imposes on the backlight. Input edges, encoder motion and
+// button presses zero the counter; after the configured timeout the cap
+// ramps down to the idle level, and activity snaps it back in one tick.
+uint32_t idle_ticks = 0;
+uint8_t idle_dim_cap = 255;
+
+// Config persistence: wear-leveled journal in the last flash sector.
+// Each save programs one fresh 256-byte page (the flash write granularity)
+// instead of erasing the sector, so the sector only sees one erase per 16
+// saves. The newest valid slot wins on load.
+#define CONFIG_FLASH_OFFSET  (PICO_FLASH_SIZE_BYTES - FLASH_SECTOR_SIZE)
+#define CONFIG_SLOT_SIZE     FLASH_PAGE_SIZE
+#define CONFIG_SLOT_COUNT    (FLASH_SECTOR_SIZE / CONFIG_SLOT_SIZE)
+#define CONFIG_MAGIC         0xC5
+#define CONFIG_PAYLOAD_SIZE  16   // Register bank bytes 0x70-0x7F
+
+typedef struct {
+    uint8_t magic;      // CONFIG_MAGIC when the slot holds a record
+    uint8_t version;    // Payload layout version (bump if 0x70-0x7F changes)
+    uint8_t checksum;   // XOR of all payload bytes
+    uint8_t reserved;
+    uint8_t payload[CONFIG_PAYLOAD_SIZE];
+} ConfigRecord;
+
+// v2: 0x75/0x76 gained peak hold/decay (was reserved, journaled as zero)
+// v3: 0x77 gained the VU slew limit
+// v4: 0x78 gained the tape motor ramp rate
+// v5: 0x79 gained the serial log levels
+// v6: 0x7A/0x7B gained the idle dim timeout and level
+// v7: 0x7C gained the host liveness window
+#define CONFIG_VERSION 7
+
+// Flash operations stall XIP, so saves requested over I2C are deferred to
+// core0's idle loop where both cores can be safely parked
+volatile bool config_save_pending = false;
+volatile bool config_factory_pending = false;
+
+// Benchmark request flag (CMD_BENCHMARK). The benchmark exercises the GPIO
+// and PWM paths, so it must run on core1; the command handler only requests.
+volatile bool bench_pending = false;
+
+// Cross-core handshake flags
+// Core0 owns the I2C slave (Wire1 interrupts) and the snapshot latch so the
+// latch can mask the I2C IRQ; core1 owns the 100Hz control loop and all GPIO.
+volatile bool core0_init_done = false;    // Register bank ready for core1
+volatile bool snapshot_pending = false;   // Core1 tick finished, core0 should latch
+
+// Hardware watchdog: core1's tick feeds it, but only while core0's idle
+// loop is still making passes, so a wedge on either core forces a reboot.
+// 2s rides out flash stalls (config saves park core1 for a few ms).
+#define WATCHDOG_TIMEOUT_MS      2000
+#define WATCHDOG_CORE0_STALE_MAX 100   // Ticks core0 may go quiet before we stop feeding
+volatile uint32_t core0_heartbeat = 0;   // Incremented every loop() pass on core0
+
+// Host liveness failsafe: the I2C handlers stamp every transaction, and
+// core1 parks the outputs (VU to zero through the slew engine, tape motor
+// ramped to a stop) when the host has been silent longer than
+// REG_CONFIG_HOST_TIMEOUT. The next transaction unparks within one tick.
+volatile uint32_t i2c_last_activity_ms = 0;
+bool failsafe_active = false;            // Core1-owned
+
+// VU ballistics state (Q8.8 fixed point, high byte = PWM level)
+uint16_t vu_level_left_q8 = 0;
+uint16_t vu_level_right_q8 = 0;
+uint16_t vu_attack_coeff_q8 = 0;    // Per-tick filter coefficient (0 = bypass)
+uint16_t vu_release_coeff_q8 = 0;
+uint8_t vu_attack_cfg_cached = 0xFF;  // Config values the coefficients were derived from
+uint8_t vu_release_cfg_cached = 0xFF;
+
+// Peak-hold envelope (VU_MODE_PEAK_HOLD): per-channel latch with hold/decay
+uint8_t vu_peak_left = 0;
+uint8_t vu_peak_right = 0;
+uint8_t vu_peak_hold_left_ticks = 0;
+uint8_t vu_peak_hold_right_ticks = 0;
+
+// VU slew stage: the 100Hz pipeline sets targets, and a 1kHz stage ramps
+// the actual PWM toward them at a bounded rate, so the needle moves
+// smoothly no matter how coarse the host update rate is
+uint16_t vu_target_left_q8 = 0;   // Set by update_pwm_outputs (100Hz)
+uint16_t vu_target_right_q8 = 0;
+uint16_t vu_slew_left_q8 = 0;     // Advanced by update_vu_slew (1kHz)
+uint16_t vu_slew_right_q8 = 0;
+
+// VU high-resolution PWM: the VU slices run a 12-bit counter, and Q8.8
+// needle levels are expanded through a calibration LUT with linear
+// interpolation between entries, so the bottom third of the scale is no
+// longer quantized to 8-bit steps. Carrier set by REG_CONFIG_VU_FREQ (kHz).
+uint16_t vu_cal_lut[256];           // 8-bit level -> 12-bit duty (default linear)
+uint8_t vu_freq_cfg_cached = 0xFF;  // Config value the divider was derived from
+
+// Tape motor ramp state: TAPE_SPEED/TAPE_DIRECTION are targets, and the
+// tick loop walks the actual H-bridge drive toward them so transitions
+// never jerk the mechanism. Direction changes ramp down through zero.
+uint8_t tape_actual_speed = 0;
+uint8_t tape_actual_direction = TAPE_DIR_STOP;
+
+// Virtual tape counter: signed odometer in speed-counts x ticks, integrated
+// from the actual (ramped) drive each 100Hz tick so the displayed count
+// tracks what the motor was really driven, not what the host managed to
+// sample. A tachometer on a spare digital input could replace the
+// commanded-speed term later without changing the registers.
+int32_t tape_odometer = 0;
+
+// VU sample FIFO (host-timestamped frames played back on the local timebase)
+typedef struct {
+    uint8_t left;       // Raw left level
+    uint8_t right;      // Raw right level
+    uint8_t hold_ms;    // Time before the next frame is applied
+} VUFrame;
+
+VUFrame vu_fifo[VU_FIFO_DEPTH];
+volatile uint8_t vu_fifo_head = 0;      // Next slot to write (I2C ISR)
+volatile uint8_t vu_fifo_tail = 0;      // Next frame to play (main loop)
+uint8_t vu_fifo_assembly[VU_FIFO_FRAME_SIZE];  // Partial frame being received
+uint8_t vu_fifo_assembly_idx = 0;
+int16_t vu_fifo_hold_remaining = 0;     // ms left on the current frame
+
+// Paired VU write (REG_VU_PAIR_DATA): a 2-byte block write stages both
+// channels here, and the tick loop latches them into vu_left/vu_right
+// together, so the needles can never split across a tick boundary
+volatile uint8_t vu_pair_left = 0;      // Published pair (write path)
+volatile uint8_t vu_pair_right = 0;
+volatile bool vu_pair_pending = false;  // Set after both bytes arrive
+uint8_t vu_pair_assembly_left = 0;      // First byte awaiting its partner
+uint8_t vu_pair_assembly_idx = 0;
+
+// Input/encoder event queue (produced by the update loop, drained over I2C)
+typedef struct {
+    uint8_t type;       // EVENT_* type code
+    uint8_t data;       // Input number, signed delta, or button state
+    uint16_t timestamp; // millis() at event time, wraps at 16 bits
+} InputEvent;
+
+InputEvent event_fifo[EVENT_FIFO_DEPTH];
+volatile uint8_t event_fifo_head = 0;   // Next slot to write (main loop)
+volatile uint8_t event_fifo_tail = 0;   // Next event to drain (I2C ISR)
+volatile uint8_t event_fifo_byte_idx = 0;  // Byte position within the event being read
+
+// Serial log rings, one per core so each is single-producer. Messages are
+// formatted at the call site and queued here; core0's idle loop drains into
+// the USB-CDC buffer as space allows, so no producer ever blocks on the
+// console. Full ring = message dropped and counted, never stalled.
+#define LOG_RING_SIZE 1024  // Per core, power of two
+#define LOG_MSG_MAX   96    // Formatted message limit including prefix
+
+typedef struct {
+    volatile uint16_t head;   // Next byte to write (producing core)
+    volatile uint16_t tail;   // Next byte to drain (core0 idle loop)
+    uint8_t buf[LOG_RING_SIZE];
+} LogRing;
+
+LogRing log_ring[2];
+volatile uint16_t log_dropped = 0;  // Messages lost to a full ring
+
 // ============================================================================
 // Function Prototypes
 // ============================================================================
 
 void setup_gpio(void);
+void setup_encoder(void);
 void setup_pwm(void);
+void setup_backlight(void);
 void setup_i2c(void);
 void update_inputs(void);
 void update_encoder(void);
+void update_vu_fifo(void);
+void update_vu_ballistics(void);
+void update_vu_slew(void);
+void update_animations(void);
 void update_pwm_outputs(void);
 void i2c_receive_handler(int byte_count);
 void i2c_request_handler(void);
 void set_motor_pwm(uint slice, uint8_t channel_a, uint8_t channel_b, uint8_t level);
-void encoder_isr(void);
+static void pwm_write_cached(uint8_t pin, uint8_t level);
+static void vu_pwm_write(uint8_t pin, uint16_t level_q8);
+static void vu_pwm_apply_freq(void);
+static void event_fifo_push(uint8_t type, uint8_t data);
+static void anim_start(uint8_t command);
+static void anim_finish(void);
+static void update_idle_dimming(void);
+static void update_failsafe(void);
+static bool config_load(void);
+static void config_save(void);
+static void config_factory_erase(void);
+static uint8_t i2c_register_peek(uint8_t reg_addr);
+static void i2c_register_consume(uint8_t reg_addr, uint8_t served);
+static void i2c_stage_response(void);
+static void i2c_rx_flush(void);
+static void run_benchmark(void);
+static uint8_t event_fifo_pop_byte(void);
+static void log_msg(uint8_t category, uint8_t level, const char *fmt, ...)
+    __attribute__((format(printf, 3, 4)));
+static void log_drain(void);
 
 // ============================================================================
-// Setup Function
+// Setup Functions (core0 = I2C service, core1 = control loop)
 // ============================================================================
 
 void setup() {
-    // Initialize serial for debugging
-    Serial.begin(115200);
-    delay(1000);
-    Serial.println("PiCorePlayer Music Streamer - RP2040 Controller");
-    Serial.println("Firmware v1.0.0");
-
-    // Initialize register bank
+    // Bring the register bank and I2C slave up first - the host may probe
+    // as soon as power is good, and nothing here depends on USB serial.
+    // With no fixed delays the device is ready well under 50ms after boot.
     i2c_registers_init();
 
-    // Setup hardware
-    setup_gpio();
-    setup_pwm();
+    // Record a watchdog reboot where the host can see it
+    if (watchdog_caused_reboot()) {
+        registers.error |= ERROR_WATCHDOG;
+    }
+
+    // Core0 owns the I2C slave so the Wire1 interrupt handlers never
+    // compete with the control loop for CPU time
     setup_i2c();
 
+    // Start the host-silence clock from I2C bring-up, not from 0
+    i2c_last_activity_ms = millis();
+
     // Set status to ready
     registers.status = STATUS_READY;
 
-    Serial.println("Initialization complete");
-    Serial.println("I2C Address: 0x42");
+    // Release core1
+    core0_init_done = true;
+
+    // USB serial enumerates in the background; log messages queue in the
+    // rings and are dropped until a host attaches, so nothing here blocks
+    Serial.begin(115200);
+    log_msg(LOG_CAT_SYS, LOG_INFO, "PiCorePlayer Music Streamer - RP2040 Controller");
+    log_msg(LOG_CAT_SYS, LOG_INFO, "Firmware v%d.%d.%d, I2C address 0x%02X",
+            FIRMWARE_VERSION_MAJOR, FIRMWARE_VERSION_MINOR,
+            FIRMWARE_VERSION_PATCH, I2C_SLAVE_ADDRESS);
+}
+
+/**
+ * @brief 1kHz scheduler tick (timer IRQ context, core1)
+ */
+static bool scheduler_tick_callback(repeating_timer_t *t) {
+    (void)t;
+    scheduler_ticks++;
+    return true;  // Keep repeating
+}
+
+void setup1() {
+    // Wait for core0 to finish initializing the register bank
+    while (!core0_init_done) {
+        delayMicroseconds(10);
+    }
+
+    // Core1 owns all GPIO, PWM and the PIO decoder
+    setup_gpio();
+    setup_encoder();
+    setup_pwm();
+    setup_backlight();
+
+    // Start the 1kHz scheduler on a core1-owned alarm pool so the timer IRQ
+    // fires on this core. The negative period schedules from the previous
+    // target time, so the timebase does not drift with callback latency.
+    core1_alarm_pool = alarm_pool_create(2, 4);
+    alarm_pool_add_repeating_timer_us(core1_alarm_pool,
+                                      -1000000 / SCHEDULER_TICK_HZ,
+                                      scheduler_tick_callback, NULL,
+                                      &scheduler_timer);
+
+    // Arm the hardware watchdog last, once both cores are running. The
+    // 100Hz tick feeds it (conditional on core0's heartbeat), so a hung
+    // loop on either core reboots into a clean state instead of leaving
+    // the needles pinned and the motor driving.
+    watchdog_enable(WATCHDOG_TIMEOUT_MS, true);
 }
 
 // ============================================================================
-// Main Loop
+// Main Loops
 // ============================================================================
 
 void loop() {
-    static uint32_t last_update = 0;
-    uint32_t now = millis();
+    // Core0: service the I2C slave (interrupt-driven) and latch the state
+    // snapshot when the control loop signals a completed tick. Latching on
+    // this core lets noInterrupts() mask the I2C IRQ during the copy.
+    if (snapshot_pending) {
+        snapshot_pending = false;
+        i2c_update_snapshot();
+    }
+
+    // Dispatch any write burst parked by the receive ISR. Masking the I2C
+    // interrupt for the dispatch keeps ordering with an arriving burst.
+    if (i2c_rx_count > 0) {
+        noInterrupts();
+        i2c_rx_flush();
+        interrupts();
+    }
+
+    // Flash work deferred from the I2C handlers: both need core1 parked and
+    // interrupts off, so they run from thread context here
+    if (config_save_pending) {
+        config_save();
+        config_save_pending = false;
+        registers.control &= ~CTRL_SAVE_CONFIG;  // Save complete
+    }
+    if (config_factory_pending) {
+        config_factory_pending = false;
+        config_factory_erase();
+        i2c_registers_init();  // Back to compiled defaults (journal now empty)
+    }
+
+    // Push any queued log output into the USB-CDC buffer, bounded by the
+    // space it has free, so this never blocks the I2C service
+    log_drain();
+
+    // Prove this core is alive; core1 stops feeding the watchdog if the
+    // heartbeat stalls for WATCHDOG_CORE0_STALE_MAX ticks
+    core0_heartbeat++;
+
+    // Sleep until the next interrupt (I2C or systick) instead of busy-waiting
+    __wfe();
+}
+
+void loop1() {
+    static uint32_t last_seen_ticks = 0;
+    static uint32_t subticks = 0;
+
+    // Sleep until the 1kHz timer advances; the timer IRQ on this core wakes WFE
+    while (scheduler_ticks == last_seen_ticks) {
+        __wfe();
+    }
+    subticks += scheduler_ticks - last_seen_ticks;
+    last_seen_ticks = scheduler_ticks;
+
+    // 1kHz stage: ramp the VU outputs toward their targets. This is the
+    // only task light enough to earn a slot on every scheduler tick.
+    update_vu_slew();
+
+    // Run the control tasks at 100Hz (every 10th scheduler tick)
+    if (subticks >= SCHEDULER_TICKS_PER_UPDATE) {
+        subticks -= SCHEDULER_TICKS_PER_UPDATE;
+        uint32_t now = millis();
+
+        // Measure tick-to-tick jitter against the nominal 10ms period
+        static uint32_t perf_prev_start = 0;
+        uint32_t tick_start = time_us_32();
+        if (perf_prev_start != 0) {
+            int32_t deviation = (int32_t)(tick_start - perf_prev_start) - 10000;
+            uint16_t jitter = (uint16_t)(deviation < 0 ? -deviation : deviation);
+            registers.perf_jitter_us_low = jitter & 0xFF;
+            registers.perf_jitter_us_high = (jitter >> 8) & 0xFF;
+            if (jitter > perf_jitter_max_us) {
+                perf_jitter_max_us = jitter;
+                registers.perf_jitter_max_low = jitter & 0xFF;
+                registers.perf_jitter_max_high = (jitter >> 8) & 0xFF;
+            }
+        }
+        perf_prev_start = tick_start;
 
-    // Update at 100Hz
-    if (now - last_update >= 10) {
-        last_update = now;
+        // Open the seqlock write side: odd means "state is in flux"
+        state_seq++;
 
         // Update inputs
         update_inputs();
@@ -115,9 +542,65 @@ void loop() {
         // Update encoder
         update_encoder();
 
+        // Play queued VU frames on the local timebase
+        update_vu_fifo();
+
+        // Run VU ballistics filters on the raw host levels
+        update_vu_ballistics();
+
+        // Advance any running test animation
+        update_animations();
+
+        // Park or unpark the outputs based on host liveness
+        update_failsafe();
+
+        // Advance the backlight idle dimming engine
+        update_idle_dimming();
+
         // Update PWM outputs from register values
         update_pwm_outputs();
 
+        // Close the seqlock write side: bank quiescent until the next tick
+        state_seq++;
+
+        // Record how long this control tick took
+        uint16_t tick_us = (uint16_t)(time_us_32() - tick_start);
+        registers.perf_tick_us_low = tick_us & 0xFF;
+        registers.perf_tick_us_high = (tick_us >> 8) & 0xFF;
+        if (tick_us > perf_tick_max_us) {
+            perf_tick_max_us = tick_us;
+            registers.perf_tick_max_low = tick_us & 0xFF;
+            registers.perf_tick_max_high = (tick_us >> 8) & 0xFF;
+        }
+
+        // Run a requested benchmark after the regular work, so its timing
+        // reflects a build under normal load (at worst it eats into this
+        // tick's idle time, never into the next tick's tasks)
+        if (bench_pending) {
+            bench_pending = false;
+            run_benchmark();
+        }
+
+        // Feed the watchdog only while core0 is still making idle-loop
+        // passes; either core wedging stops the feed and forces a reboot
+        static uint32_t hb_last = 0;
+        static uint32_t hb_stale_ticks = 0;
+        if (core0_heartbeat != hb_last) {
+            hb_last = core0_heartbeat;
+            hb_stale_ticks = 0;
+        } else {
+            hb_stale_ticks++;
+        }
+        if (hb_stale_ticks < WATCHDOG_CORE0_STALE_MAX) {
+            watchdog_update();
+        }
+
+        // Signal core0 to latch the coherent state snapshot, and wake its
+        // WFE so the latch (and the heartbeat) never wait on an interrupt
+        update_tick++;
+        snapshot_pending = true;
+        __sev();
+
         // Blink status LED
         if (now - led_last_blink >= 500) {
             led_last_blink = now;
@@ -125,9 +608,101 @@ void loop() {
             digitalWrite(PIN_STATUS_LED, led_state);
         }
     }
+}
+
+// ============================================================================
+// Serial Logging
+// ============================================================================
+
+/**
+ * @brief Queue a formatted log message from any context
+ *
+ * Gated first on an attached console and the per-category level in
+ * REG_CONFIG_LOG_LEVEL, so disabled tracing costs two loads and a compare.
+ * Each core owns its own ring, which keeps the queues single-producer; on
+ * core0 interrupts are masked for the copy so the I2C handlers and the
+ * idle loop never interleave within one ring.
+ */
+static void log_msg(uint8_t category, uint8_t level, const char *fmt, ...) {
+    if (!Serial) {
+        return;  // Headless: skip formatting entirely
+    }
+    uint8_t cat_level = (registers.config_log_level >> (category * 2)) & 0x03;
+    if (level > cat_level) {
+        return;
+    }
+
+    static const char cat_tag[4] = {'S', 'I', 'C', 'F'};
+    char msg[LOG_MSG_MAX];
+    int len = snprintf(msg, sizeof(msg), "[%8lu][%c] ",
+                       (unsigned long)millis(), cat_tag[category & 0x03]);
+
+    va_list args;
+    va_start(args, fmt);
+    len += vsnprintf(msg + len, sizeof(msg) - len - 1, fmt, args);
+    va_end(args);
+
+    if (len > (int)sizeof(msg) - 2) {
+        len = (int)sizeof(msg) - 2;  // Truncated; keep room for the newline
+    }
+    msg[len++] = '\n';
+
+    // Nested-safe masking: log_msg can be reached from inside an existing
+    // critical section (e.g. the masked i2c_rx_flush dispatch), so restore
+    // the caller's interrupt state instead of unconditionally re-enabling.
+    uint core = get_core_num();
+    LogRing *ring = &log_ring[core];
+    uint32_t irq_state = 0;
+    if (core == 0) irq_state = save_and_disable_interrupts();
+
+    uint16_t head = ring->head;
+    uint16_t free_space = (uint16_t)(ring->tail - head - 1) & (LOG_RING_SIZE - 1);
+    if ((uint16_t)len <= free_space) {
+        for (int i = 0; i < len; i++) {
+            ring->buf[(head + i) & (LOG_RING_SIZE - 1)] = msg[i];
+        }
+        // Publish after the copy so the drain never sees a partial message
+        ring->head = (head + len) & (LOG_RING_SIZE - 1);
+    } else {
+        log_dropped++;
+    }
+
+    if (core == 0) restore_interrupts(irq_state);
+}
+
+/**
+ * @brief Drain the log rings into the USB-CDC buffer (core0 idle loop)
+ *
+ * Writes at most what the CDC buffer can absorb this pass, so the drain
+ * never blocks even mid-enumeration or with a stalled host.
+ */
+static void log_drain(void) {
+    if (!Serial) {
+        return;
+    }
+
+    int budget = Serial.availableForWrite();
+    uint16_t pending_total = 0;
+    for (uint core = 0; core < 2; core++) {
+        LogRing *ring = &log_ring[core];
+        uint16_t tail = ring->tail;
+        uint16_t pending = (uint16_t)(ring->head - tail) & (LOG_RING_SIZE - 1);
+        while (pending > 0 && budget > 0) {
+            Serial.write(ring->buf[tail]);
+            tail = (tail + 1) & (LOG_RING_SIZE - 1);
+            pending--;
+            budget--;
+        }
+        ring->tail = tail;
+        pending_total += pending;
+    }
 
-    // Small delay to prevent busy-waiting
-    delay(1);
+    // Once caught up, own up to anything lost while the rings were full
+    if (log_dropped > 0 && pending_total == 0 && budget > 0) {
+        uint16_t dropped = log_dropped;
+        log_dropped = 0;
+        Serial.printf("[log] %u messages dropped\n", dropped);
+    }
 }
 
 // ============================================================================
@@ -144,16 +719,43 @@ void setup_gpio() {
         pinMode(DIGITAL_INPUT_PINS[i], INPUT_PULLUP);
     }
 
-    // Configure encoder inputs with pull-ups
+    // Configure encoder inputs with pull-ups (decoded by PIO, see setup_encoder)
     pinMode(PIN_ENCODER_A, INPUT_PULLUP);
     pinMode(PIN_ENCODER_B, INPUT_PULLUP);
     pinMode(PIN_ENCODER_BTN, INPUT_PULLUP);
 
-    // Attach interrupts for encoder
-    attachInterrupt(digitalPinToInterrupt(PIN_ENCODER_A), encoder_isr, CHANGE);
-    attachInterrupt(digitalPinToInterrupt(PIN_ENCODER_B), encoder_isr, CHANGE);
+    log_msg(LOG_CAT_SYS, LOG_INFO, "GPIO configured");
+}
+
+// ============================================================================
+// Encoder Setup (PIO Quadrature Decoder)
+// ============================================================================
+
+void setup_encoder() {
+    encoder_pio_sm = pio_claim_unused_sm(encoder_pio, true);
+    uint offset = pio_add_program(encoder_pio, &encoder_pio_program);
+
+    pio_sm_config c = pio_get_default_sm_config();
+    sm_config_set_in_pins(&c, PIN_ENCODER_A);  // GP10 = bit 0, GP11 = bit 1
+    sm_config_set_in_shift(&c, false, false, 32);  // Shift left, no autopush
+    sm_config_set_fifo_join(&c, PIO_FIFO_JOIN_RX);  // 8-entry RX FIFO
+
+    // Sample slowly enough to filter contact bounce but far faster than any
+    // physical rotation (the sample loop is ~6 SM cycles per iteration)
+    sm_config_set_clkdiv(&c, (float)F_CPU / (6.0f * ENCODER_PIO_SAMPLE_HZ));
+
+    pio_sm_init(encoder_pio, encoder_pio_sm, offset, &c);
 
-    Serial.println("GPIO configured");
+    // Seed the decoder state from the current pin levels so the first
+    // transition is counted correctly
+    uint8_t a = digitalRead(PIN_ENCODER_A);
+    uint8_t b = digitalRead(PIN_ENCODER_B);
+    encoder_state = (a << 1) | b;
+
+    pio_sm_clear_fifos(encoder_pio, encoder_pio_sm);
+    pio_sm_set_enabled(encoder_pio, encoder_pio_sm, true);
+
+    log_msg(LOG_CAT_SYS, LOG_INFO, "PIO quadrature decoder configured");
 }
 
 // ============================================================================
@@ -161,36 +763,66 @@ void setup_gpio() {
 // ============================================================================
 
 void setup_pwm() {
-    // Configure PWM pins as outputs
-    pinMode(PIN_VU_LEFT_IN1, OUTPUT);
-    pinMode(PIN_VU_LEFT_IN2, OUTPUT);
-    pinMode(PIN_VU_RIGHT_IN1, OUTPUT);
-    pinMode(PIN_VU_RIGHT_IN2, OUTPUT);
-    pinMode(PIN_BACKLIGHT_IN1, OUTPUT);
-    pinMode(PIN_BACKLIGHT_IN2, OUTPUT);
-    pinMode(PIN_TAPE_MOTOR_IN1, OUTPUT);
-    pinMode(PIN_TAPE_MOTOR_IN2, OUTPUT);
-
-    // Set PWM frequency (1kHz)
-    // RP2040 system clock is 125MHz
-    // For 1kHz PWM with 8-bit resolution (0-255):
-    // PWM frequency = clock / (wrap + 1) / divider
-    // 1000 Hz = 125000000 / 256 / divider
-    // divider = 125000000 / 256 / 1000 = 488.28
-    analogWriteFreq(1000);  // 1kHz
-    analogWriteRange(255);  // 8-bit resolution
+    // Each H-bridge input pair shares one PWM slice (GP0/1, GP4/5, GP6/7,
+    // GP8/9), so four slices cover all outputs
+    static const uint8_t pwm_pins[] = {
+        PIN_VU_LEFT_IN1, PIN_VU_LEFT_IN2,
+        PIN_VU_RIGHT_IN1, PIN_VU_RIGHT_IN2,
+        PIN_BACKLIGHT_IN1, PIN_BACKLIGHT_IN2,
+        PIN_TAPE_MOTOR_IN1, PIN_TAPE_MOTOR_IN2
+    };
+
+    for (uint i = 0; i < sizeof(pwm_pins); i++) {
+        gpio_set_function(pwm_pins[i], GPIO_FUNC_PWM);
+    }
+
+    slice_vu_left = pwm_gpio_to_slice_num(PIN_VU_LEFT_IN1);
+    slice_vu_right = pwm_gpio_to_slice_num(PIN_VU_RIGHT_IN1);
+    slice_backlight = pwm_gpio_to_slice_num(PIN_BACKLIGHT_IN1);
+    slice_tape_motor = pwm_gpio_to_slice_num(PIN_TAPE_MOTOR_IN1);
+
+    // Backlight and tape slices: 10-bit counter at 1kHz
+    // PWM frequency = clock / (divider * (wrap + 1))
+    // divider = 133MHz / (1024 * 1000Hz) = 129.88 (fits the 8.4-bit divider)
+    pwm_config cfg = pwm_get_default_config();
+    pwm_config_set_wrap(&cfg, PWM_COUNTER_WRAP);
+    pwm_config_set_clkdiv(&cfg, (float)F_CPU / ((PWM_COUNTER_WRAP + 1) * (float)BACKLIGHT_PWM_FREQUENCY));
+
+    pwm_init(slice_backlight, &cfg, true);
+    pwm_init(slice_tape_motor, &cfg, true);
+
+    // VU slices: 12-bit counter, carrier from REG_CONFIG_VU_FREQ
+    pwm_config vu_cfg = pwm_get_default_config();
+    pwm_config_set_wrap(&vu_cfg, VU_PWM_WRAP);
+    pwm_init(slice_vu_left, &vu_cfg, true);
+    pwm_init(slice_vu_right, &vu_cfg, true);
+    vu_pwm_apply_freq();
+
+    // Calibration LUT starts linear; a calibration table can replace the
+    // entries without touching the PWM path
+    for (uint i = 0; i < 256; i++) {
+        vu_cal_lut[i] = (uint16_t)(((uint32_t)i * (VU_PWM_WRAP + 1)) / 255);
+    }
+
+    // Mark every duty cache entry as never-written
+    memset(pwm_last_level, 0xFF, sizeof(pwm_last_level));
 
     // Initialize all PWM outputs to 0
-    analogWrite(PIN_VU_LEFT_IN1, 0);
-    analogWrite(PIN_VU_LEFT_IN2, 0);
-    analogWrite(PIN_VU_RIGHT_IN1, 0);
-    analogWrite(PIN_VU_RIGHT_IN2, 0);
-    analogWrite(PIN_BACKLIGHT_IN1, 0);
-    analogWrite(PIN_BACKLIGHT_IN2, 0);
-    analogWrite(PIN_TAPE_MOTOR_IN1, 0);
-    analogWrite(PIN_TAPE_MOTOR_IN2, 0);
+    for (uint i = 0; i < sizeof(pwm_pins); i++) {
+        pwm_write_cached(pwm_pins[i], 0);
+    }
+
+    log_msg(LOG_CAT_SYS, LOG_INFO, "PWM configured");
+}
 
-    Serial.println("PWM configured");
+void setup_backlight() {
+    // Precompute the gamma 2.2 curve so the AUTO/PULSE effects map linear
+    // effect levels to perceptually linear brightness. Computed once at boot;
+    // lookups in the tick are a single indexed load.
+    for (uint i = 0; i < 256; i++) {
+        float normalized = (float)i / 255.0f;
+        backlight_gamma_lut[i] = (uint8_t)(powf(normalized, 2.2f) * 255.0f + 0.5f);
+    }
 }
 
 // ============================================================================
@@ -198,16 +830,20 @@ void setup_pwm() {
 // ============================================================================
 
 void setup_i2c() {
-    // Initialize I2C1 as slave
+    // Initialize I2C1 as slave. The master sets the actual bus rate; the
+    // clock here sizes the peripheral's spike filter and hold times so the
+    // slave is qualified up to 1MHz Fm+ (set dtparam=i2c_arm_baudrate on
+    // the Pi to match).
     Wire1.setSDA(PIN_I2C_SDA);
     Wire1.setSCL(PIN_I2C_SCL);
+    Wire1.setClock(I2C_BUS_SPEED_HZ);
     Wire1.begin(I2C_SLAVE_ADDRESS);
 
     // Register I2C event handlers
     Wire1.onReceive(i2c_receive_handler);
     Wire1.onRequest(i2c_request_handler);
 
-    Serial.println("I2C slave configured at address 0x42");
+    log_msg(LOG_CAT_SYS, LOG_INFO, "I2C slave configured at address 0x%02X", I2C_SLAVE_ADDRESS);
 }
 
 // ============================================================================
@@ -215,84 +851,97 @@ void setup_i2c() {
 // ============================================================================
 
 void update_inputs() {
-    uint32_t now = millis();
+    // Apply a host-staged clear before sampling so any edge landing in
+    // this very tick still sets the flags afresh
+    if (input_clear_pending) {
+        input_clear_pending = false;
+        registers.input_changed_low = 0;
+        registers.input_changed_high = 0;
+        registers.status &= ~STATUS_INPUT_CHANGED;
+    }
+
+    // Clear-on-read acknowledges staged by the I2C consume handlers: only
+    // the bits the host actually saw are cleared, so an edge committing
+    // after the serve (or after the snapshot latch) survives to the next poll
+    bool input_acked = false;
+    if (changed_low_ack_mask) {
+        registers.input_changed_low &= ~changed_low_ack_mask;
+        changed_low_ack_mask = 0;
+        input_acked = true;
+    }
+    if (changed_high_ack_mask) {
+        registers.input_changed_high &= ~changed_high_ack_mask;
+        changed_high_ack_mask = 0;
+        input_acked = true;
+    }
+    if (input_acked && registers.input_changed_low == 0 &&
+        registers.input_changed_high == 0) {
+        registers.status &= ~STATUS_INPUT_CHANGED;
+    }
 
-    // Read digital inputs
-    uint8_t new_state_low = 0xFF;
-    uint8_t new_state_high = 0x0F;
+    // Read the entire GPIO bank in a single cycle and gather the input bits
+    uint32_t gpio = gpio_get_all();
 
+    uint16_t raw = 0;
     for (int i = 0; i < NUM_DIGITAL_INPUTS; i++) {
-        bool state = digitalRead(DIGITAL_INPUT_PINS[i]);
-
-        // Debounce
-        if (state != ((i < 8 ? input_state_low : input_state_high) & (1 << (i % 8)))) {
-            if (now - input_last_change[i] >= INPUT_DEBOUNCE_MS) {
-                input_last_change[i] = now;
-                if (i < 8) {
-                    if (state) {
-                        new_state_low |= (1 << i);
-                    } else {
-                        new_state_low &= ~(1 << i);
-                    }
-                } else {
-                    if (state) {
-                        new_state_high |= (1 << (i - 8));
-                    } else {
-                        new_state_high &= ~(1 << (i - 8));
-                    }
-                }
-            } else {
-                // Keep old state during debounce
-                if (i < 8) {
-                    if (input_state_low & (1 << i)) {
-                        new_state_low |= (1 << i);
-                    } else {
-                        new_state_low &= ~(1 << i);
-                    }
-                } else {
-                    if (input_state_high & (1 << (i - 8))) {
-                        new_state_high |= (1 << (i - 8));
-                    } else {
-                        new_state_high &= ~(1 << (i - 8));
-                    }
-                }
-            }
-        } else {
-            // State unchanged
-            if (i < 8) {
-                if (state) {
-                    new_state_low |= (1 << i);
-                } else {
-                    new_state_low &= ~(1 << i);
-                }
-            } else {
-                if (state) {
-                    new_state_high |= (1 << (i - 8));
-                } else {
-                    new_state_high &= ~(1 << (i - 8));
-                }
-            }
+        if (gpio & (1ul << DIGITAL_INPUT_PINS[i])) {
+            raw |= (1 << i);
         }
     }
 
+    // Derive the counter cadence from CONFIG_DEBOUNCE: the 2-bit counter
+    // needs 4 consecutive differing samples, so the window rounds to the
+    // nearest multiple of 40ms (minimum one tick between advances)
+    if (registers.config_debounce != input_debounce_cfg_cached) {
+        input_debounce_cfg_cached = registers.config_debounce;
+        uint8_t stride = (uint8_t)((input_debounce_cfg_cached + 20) / 40);
+        input_debounce_stride = stride ? stride : 1;
+        input_debounce_phase = 0;
+    }
+
+    // Vertical-counter debounce: each bit of vcount1:vcount0 is a 2-bit
+    // counter that advances while the raw sample disagrees with the
+    // debounced state and resets when it agrees; the state flips only after
+    // the counter rolls over (4 consecutive differing samples)
+    uint16_t commit = 0;
+    if (++input_debounce_phase >= input_debounce_stride) {
+        input_debounce_phase = 0;
+        uint16_t diff = raw ^ input_debounced;
+        input_vcount1 = (input_vcount1 ^ input_vcount0) & diff;
+        input_vcount0 = ~input_vcount0 & diff;
+        commit = diff & ~(input_vcount0 | input_vcount1);
+        input_debounced ^= commit;
+    }
+
+    uint8_t new_state_low = input_debounced & 0xFF;
+    uint8_t new_state_high = (input_debounced >> 8) & 0x0F;
+
     // Detect changes
-    uint8_t changed_low = input_state_low ^ new_state_low;
-    uint8_t changed_high = input_state_high ^ new_state_high;
+    uint8_t changed_low = commit & 0xFF;
+    uint8_t changed_high = (commit >> 8) & 0x0F;
 
     if (changed_low || changed_high) {
         registers.input_changed_low |= changed_low;
         registers.input_changed_high |= changed_high;
         registers.status |= STATUS_INPUT_CHANGED;
+        idle_ticks = 0;  // Any edge counts as user activity
+
+        // Queue a timestamped event per edge (inputs are active low)
+        for (int i = 0; i < NUM_DIGITAL_INPUTS; i++) {
+            uint8_t mask = 1 << (i % 8);
+            uint8_t changed = (i < 8) ? (changed_low & mask) : (changed_high & mask);
+            if (changed) {
+                bool pressed = ((i < 8 ? new_state_low : new_state_high) & mask) == 0;
+                event_fifo_push(pressed ? EVENT_INPUT_PRESS : EVENT_INPUT_RELEASE, i + 1);
+            }
+        }
     }
 
-    input_state_low = new_state_low;
-    input_state_high = new_state_high;
-
-    registers.input_status_low = input_state_low;
-    registers.input_status_high = input_state_high;
+    registers.input_status_low = new_state_low;
+    registers.input_status_high = new_state_high;
 
-    // Update encoder button
-    bool btn_pressed = !digitalRead(PIN_ENCODER_BTN);
+    // Update encoder button (from the same bank sample)
+    bool btn_pressed = !(gpio & (1ul << PIN_ENCODER_BTN));
     uint32_t now_ms = millis();
 
     if (btn_pressed && encoder_button_state == ENC_BTN_RELEASED) {
@@ -300,6 +949,7 @@ void update_inputs() {
         encoder_button_state = ENC_BTN_PRESSED;
         encoder_button_press_time = now_ms;
         registers.status |= STATUS_BUTTON_PRESSED;
+        idle_ticks = 0;
 
         // Check for double-click
         if (now_ms - encoder_button_last_release < 300) {
@@ -317,213 +967,1434 @@ void update_inputs() {
         registers.status &= ~STATUS_BUTTON_PRESSED;
     }
 
+    // Queue button transitions (registers.encoder_button holds the previous state)
+    if (encoder_button_state != registers.encoder_button) {
+        event_fifo_push(EVENT_BUTTON, encoder_button_state);
+    }
+
     registers.encoder_button = encoder_button_state;
 }
 
 void update_encoder() {
-    // Update encoder position in registers
-    noInterrupts();
+    // State transition table for quadrature decoding
+    // Rows are the previous state, columns the new state ((A << 1) | B)
+    static const int8_t transition_table[4][4] = {
+        { 0, -1,  1,  0},  // 00 -> 00, 01, 10, 11
+        { 1,  0,  0, -1},  // 01 -> 00, 01, 10, 11
+        {-1,  0,  0,  1},  // 10 -> 00, 01, 10, 11
+        { 0,  1, -1,  0}   // 11 -> 00, 01, 10, 11
+    };
+
+    // Apply a host-staged reset before accumulating this tick's motion so
+    // the zero point lands on a tick boundary, inside the seqlock
+    if (encoder_reset_pending) {
+        encoder_reset_pending = false;
+        encoder_position = 0;
+    }
+
+    // Delta read acknowledge staged by the I2C consume handler; motion in
+    // this very tick re-asserts the flag below
+    if (encoder_ack_pending) {
+        encoder_ack_pending = false;
+        registers.status &= ~STATUS_ENCODER_CHANGED;
+    }
+
+    // Drain the pin states captured by the PIO state machine
+    int16_t delta = 0;
+    while (!pio_sm_is_rx_fifo_empty(encoder_pio, encoder_pio_sm)) {
+        uint32_t sample = pio_sm_get(encoder_pio, encoder_pio_sm);
+        uint8_t a = sample & 0x01;         // GP10 is in-pin bit 0
+        uint8_t b = (sample >> 1) & 0x01;  // GP11 is in-pin bit 1
+        uint8_t new_state = (a << 1) | b;
+
+        delta += transition_table[encoder_state][new_state];
+        encoder_state = new_state;
+    }
+
+    encoder_position += delta;
     int16_t pos = encoder_position;
-    int8_t delta = encoder_delta;
-    encoder_delta = 0;  // Clear delta after reading
-    interrupts();
+
+    // Clamp the per-tick delta to the signed 8-bit register range
+    if (delta > 127) delta = 127;
+    if (delta < -128) delta = -128;
 
     registers.encoder_pos_low = pos & 0xFF;
     registers.encoder_pos_high = (pos >> 8) & 0xFF;
-    registers.encoder_delta = delta;
+    registers.encoder_delta = (int8_t)delta;
 
     if (delta != 0) {
         registers.status |= STATUS_ENCODER_CHANGED;
+        event_fifo_push(EVENT_ENCODER_DELTA, (uint8_t)delta);
+        idle_ticks = 0;
     }
 }
 
-void update_pwm_outputs() {
-    // Check if outputs are enabled
-    bool vu_enabled = registers.control & CTRL_VU_ENABLE;
-    bool backlight_enabled = registers.control & CTRL_BACKLIGHT_ENABLE;
-    bool tape_enabled = registers.control & CTRL_TAPE_ENABLE;
+/**
+ * @brief Refresh the VU FIFO count/space registers from the ring indices
+ */
+static void vu_fifo_refresh_regs() {
+    uint8_t count = (uint8_t)((vu_fifo_head - vu_fifo_tail + VU_FIFO_DEPTH) % VU_FIFO_DEPTH);
+    registers.vu_fifo_count = count;
+    registers.vu_fifo_space = VU_FIFO_DEPTH - 1 - count;
+}
 
-    // Update VU meters
-    if (vu_enabled && registers.vu_mode != VU_MODE_OFF) {
-        analogWrite(PIN_VU_LEFT_IN1, registers.vu_left);
-        analogWrite(PIN_VU_LEFT_IN2, 0);
-        analogWrite(PIN_VU_RIGHT_IN1, registers.vu_right);
-        analogWrite(PIN_VU_RIGHT_IN2, 0);
-        registers.status |= STATUS_VU_ACTIVE;
-    } else {
-        analogWrite(PIN_VU_LEFT_IN1, 0);
-        analogWrite(PIN_VU_LEFT_IN2, 0);
-        analogWrite(PIN_VU_RIGHT_IN1, 0);
-        analogWrite(PIN_VU_RIGHT_IN2, 0);
-        registers.status &= ~STATUS_VU_ACTIVE;
+/**
+ * @brief Accept one byte written to the VU FIFO data port (I2C ISR context)
+ *
+ * Bytes are assembled into (left, right, hold_ms) frames; a complete frame
+ * is committed to the ring. If the ring is full the frame is dropped and the
+ * overflow error flag is set.
+ */
+static void vu_fifo_push_byte(uint8_t value) {
+    vu_fifo_assembly[vu_fifo_assembly_idx++] = value;
+    if (vu_fifo_assembly_idx < VU_FIFO_FRAME_SIZE) {
+        return;
     }
+    vu_fifo_assembly_idx = 0;
 
-    // Update backlight
-    if (backlight_enabled && registers.backlight_mode != BACKLIGHT_MODE_OFF) {
-        analogWrite(PIN_BACKLIGHT_IN1, registers.backlight);
-        analogWrite(PIN_BACKLIGHT_IN2, 0);
-        registers.status |= STATUS_BACKLIGHT_ON;
-    } else {
-        analogWrite(PIN_BACKLIGHT_IN1, 0);
-        analogWrite(PIN_BACKLIGHT_IN2, 0);
-        registers.status &= ~STATUS_BACKLIGHT_ON;
+    uint8_t next_head = (vu_fifo_head + 1) % VU_FIFO_DEPTH;
+    if (next_head == vu_fifo_tail) {
+        registers.error |= ERROR_I2C_OVERFLOW;
+        return;
     }
 
-    // Update tape motor
-    if (tape_enabled && registers.tape_mode != TAPE_MODE_OFF) {
-        switch (registers.tape_direction) {
-            case TAPE_DIR_FORWARD:
-                analogWrite(PIN_TAPE_MOTOR_IN1, registers.tape_speed);
-                analogWrite(PIN_TAPE_MOTOR_IN2, 0);
-                registers.status |= STATUS_TAPE_RUNNING;
-                break;
-            case TAPE_DIR_REVERSE:
-                analogWrite(PIN_TAPE_MOTOR_IN1, 0);
-                analogWrite(PIN_TAPE_MOTOR_IN2, registers.tape_speed);
-                registers.status |= STATUS_TAPE_RUNNING;
-                break;
-            case TAPE_DIR_BRAKE:
-                analogWrite(PIN_TAPE_MOTOR_IN1, 255);
-                analogWrite(PIN_TAPE_MOTOR_IN2, 255);
-                registers.status &= ~STATUS_TAPE_RUNNING;
-                break;
-            case TAPE_DIR_STOP:
-            default:
-                analogWrite(PIN_TAPE_MOTOR_IN1, 0);
-                analogWrite(PIN_TAPE_MOTOR_IN2, 0);
-                registers.status &= ~STATUS_TAPE_RUNNING;
-                break;
-        }
-    } else {
-        analogWrite(PIN_TAPE_MOTOR_IN1, 0);
-        analogWrite(PIN_TAPE_MOTOR_IN2, 0);
-        registers.status &= ~STATUS_TAPE_RUNNING;
-    }
+    vu_fifo[vu_fifo_head].left = vu_fifo_assembly[0];
+    vu_fifo[vu_fifo_head].right = vu_fifo_assembly[1];
+    vu_fifo[vu_fifo_head].hold_ms = vu_fifo_assembly[2];
+    vu_fifo_head = next_head;
+    vu_fifo_refresh_regs();
 }
 
-// ============================================================================
-// I2C Handlers
-// ============================================================================
+/**
+ * @brief Assemble a paired VU write (left, right) from the pair port
+ *
+ * The pair is published only after both bytes have arrived, so a torn
+ * transaction can never half-apply. Writes within one burst replace any
+ * pair the tick loop has not consumed yet - last value wins, same as
+ * direct register writes.
+ */
+static void vu_pair_push_byte(uint8_t value) {
+    if (vu_pair_assembly_idx == 0) {
+        vu_pair_assembly_left = value;
+        vu_pair_assembly_idx = 1;
+        return;
+    }
+    vu_pair_assembly_idx = 0;
 
-void i2c_receive_handler(int byte_count) {
-    if (byte_count < 1) return;
+    vu_pair_left = vu_pair_assembly_left;
+    vu_pair_right = value;
+    vu_pair_pending = true;  // Publish after both halves are in place
+}
 
-    // First byte is register address
-    current_register = Wire1.read();
-    byte_count--;
+void update_vu_fifo() {
+    if (vu_fifo_head == vu_fifo_tail) {
+        return;  // Empty - host drives REG_VU_LEFT/RIGHT directly
+    }
 
-    // If there are more bytes, this is a write operation
-    while (byte_count > 0) {
-        uint8_t value = Wire1.read();
-        i2c_register_write(current_register, value);
-        current_register++;
-        byte_count--;
+    // Count down the current frame's hold time on the local 10ms timebase,
+    // then apply queued frames until one with hold time remains pending.
+    // The loop runs strictly below zero: a frame whose hold expires exactly
+    // this tick is still displayed for this tick, so back-to-back 10ms
+    // frames play one per tick from the first frame on
+    vu_fifo_hold_remaining -= 10;
+    while (vu_fifo_hold_remaining < 0 && vu_fifo_head != vu_fifo_tail) {
+        VUFrame frame = vu_fifo[vu_fifo_tail];
+        vu_fifo_tail = (vu_fifo_tail + 1) % VU_FIFO_DEPTH;
+
+        registers.vu_left = frame.left;
+        registers.vu_right = frame.right;
+        vu_fifo_hold_remaining += frame.hold_ms;
     }
+    if (vu_fifo_hold_remaining < 0) {
+        vu_fifo_hold_remaining = 0;
+    }
+    vu_fifo_refresh_regs();
 }
 
-void i2c_request_handler() {
-    // Send requested register value
-    uint8_t value = i2c_register_read(current_register);
-    Wire1.write(value);
-    current_register++;
-}
+/**
+ * @brief Queue a timestamped input/encoder event (main loop context)
+ *
+ * If the queue is full the incoming event is dropped and the overflow
+ * error is set; the drain indices stay untouched (core0-owned).
+ */
+static void event_fifo_push(uint8_t type, uint8_t data) {
+    uint8_t next_head = (event_fifo_head + 1) % EVENT_FIFO_DEPTH;
+
+    if (next_head == event_fifo_tail) {
+        // Queue full: drop the incoming event. The tail (and the partial
+        // read index) stay core0-owned - advancing them here would break
+        // the single-producer/single-consumer contract mid-drain. The
+        // overflow flag tells the host an edge was lost either way.
+        registers.error |= ERROR_EVENT_OVERFLOW;
+        return;
+    }
 
-// ============================================================================
-// Encoder ISR
-// ============================================================================
+    event_fifo[event_fifo_head].type = type;
+    event_fifo[event_fifo_head].data = data;
+    event_fifo[event_fifo_head].timestamp = (uint16_t)millis();
+    event_fifo_head = next_head;
 
-void encoder_isr() {
-    // Read encoder pins
-    uint8_t a = digitalRead(PIN_ENCODER_A);
-    uint8_t b = digitalRead(PIN_ENCODER_B);
+    registers.event_fifo_count =
+        (uint8_t)((event_fifo_head - event_fifo_tail + EVENT_FIFO_DEPTH) % EVENT_FIFO_DEPTH);
+}
 
-    // Combine into 2-bit state
-    uint8_t new_state = (a << 1) | b;
+/**
+ * @brief Stream the next byte of the event queue (I2C ISR context)
+ *
+ * Events are drained byte-by-byte in (type, data, ts_low, ts_high) order;
+ * the event is popped once its last byte has been read. An empty queue
+ * reads as EVENT_NONE (all zeros).
+ */
+static uint8_t event_fifo_pop_byte() {
+    if (event_fifo_head == event_fifo_tail) {
+        return 0;
+    }
 
-    // State transition table for quadrature decoding
-    // encoder_state is previous state, new_state is current state
-    static const int8_t transition_table[4][4] = {
-        { 0, -1,  1,  0},  // 00 -> 00, 01, 10, 11
-        { 1,  0,  0, -1},  // 01 -> 00, 01, 10, 11
-        {-1,  0,  0,  1},  // 10 -> 00, 01, 10, 11
-        { 0,  1, -1,  0}   // 11 -> 00, 01, 10, 11
-    };
+    InputEvent *evt = &event_fifo[event_fifo_tail];
+    uint8_t value = 0;
 
-    int8_t delta = transition_table[encoder_state][new_state];
-    encoder_state = new_state;
+    switch (event_fifo_byte_idx) {
+        case 0: value = evt->type; break;
+        case 1: value = evt->data; break;
+        case 2: value = evt->timestamp & 0xFF; break;
+        case 3: value = (evt->timestamp >> 8) & 0xFF; break;
+    }
 
-    if (delta != 0) {
-        encoder_position += delta;
-        encoder_delta += delta;
+    event_fifo_byte_idx++;
+    if (event_fifo_byte_idx >= EVENT_SIZE) {
+        event_fifo_byte_idx = 0;
+        event_fifo_tail = (event_fifo_tail + 1) % EVENT_FIFO_DEPTH;
+        registers.event_fifo_count =
+            (uint8_t)((event_fifo_head - event_fifo_tail + EVENT_FIFO_DEPTH) % EVENT_FIFO_DEPTH);
     }
+
+    return value;
 }
 
-// ============================================================================
-// Register Functions
-// ============================================================================
+/**
+ * @brief Convert a ballistics time constant register to a per-tick coefficient
+ *
+ * The register holds the time for the needle to reach 99% of a step in 10ms
+ * units (ANSI C16.5 specifies 300ms). For a one-pole filter, 99% in time t99
+ * means alpha = 1 - exp(-ln(100) * dt / t99) per dt = 10ms tick.
+ *
+ * @param cfg Time constant register value (10ms units, 0 = bypass)
+ * @return Q8.8 filter coefficient (0 = bypass, 256 = instant)
+ */
+static uint16_t vu_ballistics_coeff(uint8_t cfg) {
+    if (cfg == 0) {
+        return 0;  // Bypass - needle follows raw level directly
+    }
+    float alpha = 1.0f - expf(-4.605f / (float)cfg);  // ln(100) = 4.605, dt = 1 unit
+    uint16_t coeff = (uint16_t)(alpha * 256.0f + 0.5f);
+    return coeff > 0 ? coeff : 1;
+}
 
-void i2c_registers_init() {
-    memset(&registers, 0, sizeof(registers));
+/**
+ * @brief Advance a Q8.8 one-pole ballistics filter by one tick
+ */
+static uint16_t vu_filter_step(uint16_t level_q8, uint8_t target,
+                               uint16_t attack_q8, uint16_t release_q8) {
+    uint16_t target_q8 = (uint16_t)target << 8;
+    uint16_t coeff = (target_q8 > level_q8) ? attack_q8 : release_q8;
 
-    // Initialize device info
-    registers.device_id = DEVICE_ID;
-    registers.fw_ver_major = FIRMWARE_VERSION_MAJOR;
-    registers.fw_ver_minor = FIRMWARE_VERSION_MINOR;
-    registers.fw_ver_patch = FIRMWARE_VERSION_PATCH;
+    if (coeff == 0) {
+        return target_q8;  // Filter bypassed
+    }
 
-    // Initialize default values
-    registers.control = CTRL_ENABLE;
-    registers.status = STATUS_READY;
-    registers.vu_mode = VU_MODE_NORMAL;
-    registers.backlight = 128;
-    registers.backlight_mode = BACKLIGHT_MODE_MANUAL;
-    registers.tape_direction = TAPE_DIR_STOP;
-    registers.tape_mode = TAPE_MODE_MANUAL;
-    registers.input_status_low = 0xFF;
-    registers.input_status_high = 0x0F;
-    registers.config_vu_freq = 1;
-    registers.config_debounce = INPUT_DEBOUNCE_MS;
+    int32_t diff = (int32_t)target_q8 - (int32_t)level_q8;
+    return (uint16_t)((int32_t)level_q8 + ((diff * (int32_t)coeff) >> 8));
 }
 
-uint8_t i2c_register_read(uint8_t reg_addr) {
-    // Bounds check
-    if (reg_addr >= sizeof(I2CRegisterBank)) {
-        registers.error |= ERROR_INVALID_REG;
-        return 0xFF;
+void update_vu_ballistics() {
+    // Latch a completed paired write so both channels land in the same tick.
+    // The retry loop re-copies if core0 publishes a new pair mid-copy.
+    if (vu_pair_pending) {
+        uint8_t pair_left, pair_right;
+        do {
+            vu_pair_pending = false;
+            pair_left = vu_pair_left;
+            pair_right = vu_pair_right;
+        } while (vu_pair_pending);
+        registers.vu_left = pair_left;
+        registers.vu_right = pair_right;
     }
 
-    // Read from register bank
-    uint8_t *reg_ptr = (uint8_t*)&registers;
-    uint8_t value = reg_ptr[reg_addr];
-
-    // Auto-clear flags on read
-    if (reg_addr == REG_INPUT_CHANGED_LOW) {
-        registers.input_changed_low = 0;
-        if (registers.input_changed_high == 0) {
-            registers.status &= ~STATUS_INPUT_CHANGED;
+    // Recompute coefficients when the host changes the time constants
+    if (registers.config_vu_attack != vu_attack_cfg_cached) {
+        vu_attack_cfg_cached = registers.config_vu_attack;
+        vu_attack_coeff_q8 = vu_ballistics_coeff(vu_attack_cfg_cached);
+    }
+    if (registers.config_vu_release != vu_release_cfg_cached) {
+        vu_release_cfg_cached = registers.config_vu_release;
+        vu_release_coeff_q8 = vu_ballistics_coeff(vu_release_cfg_cached);
+    }
+
+    // Integrate toward the raw host levels in REG_VU_LEFT/RIGHT
+    vu_level_left_q8 = vu_filter_step(vu_level_left_q8, registers.vu_left,
+                                      vu_attack_coeff_q8, vu_release_coeff_q8);
+    vu_level_right_q8 = vu_filter_step(vu_level_right_q8, registers.vu_right,
+                                       vu_attack_coeff_q8, vu_release_coeff_q8);
+}
+
+/**
+ * @brief Start a test animation for one of the CMD_TEST_* commands
+ *
+ * Saves the output registers the pattern will drive so they can be put back
+ * when the sweep completes. The I2C handler only records the request here;
+ * all stepping happens in update_animations() on the control loop, so test
+ * patterns never block the bus or the 100Hz tick.
+ */
+static void anim_start(uint8_t command) {
+    if (anim_active != CMD_NOP) {
+        anim_finish();  // Restore before switching patterns
+    }
+    log_msg(LOG_CAT_CTRL, LOG_DEBUG, "anim: start 0x%02X", command);
+
+    anim_saved_vu_left = registers.vu_left;
+    anim_saved_vu_right = registers.vu_right;
+    anim_saved_backlight = registers.backlight;
+    anim_saved_tape_speed = registers.tape_speed;
+    anim_saved_tape_direction = registers.tape_direction;
+
+    anim_step = 0;
+    anim_active = command;
+    registers.anim_active = command;  // Host-visible busy byte
+}
+
+/**
+ * @brief Restore the saved output registers and mark the engine idle
+ */
+static void anim_finish(void) {
+    switch (anim_active) {
+        case CMD_TEST_VU_LEFT:
+            registers.vu_left = anim_saved_vu_left;
+            break;
+        case CMD_TEST_VU_RIGHT:
+            registers.vu_right = anim_saved_vu_right;
+            break;
+        case CMD_TEST_VU_BOTH:
+            registers.vu_left = anim_saved_vu_left;
+            registers.vu_right = anim_saved_vu_right;
+            break;
+        case CMD_TEST_BACKLIGHT:
+            registers.backlight = anim_saved_backlight;
+            break;
+        case CMD_TEST_TAPE_MOTOR:
+            registers.tape_speed = anim_saved_tape_speed;
+            registers.tape_direction = anim_saved_tape_direction;
+            break;
+        case CMD_TEST_ALL:
+            registers.vu_left = anim_saved_vu_left;
+            registers.vu_right = anim_saved_vu_right;
+            registers.backlight = anim_saved_backlight;
+            registers.tape_speed = anim_saved_tape_speed;
+            registers.tape_direction = anim_saved_tape_direction;
+            break;
+        default:
+            break;
+    }
+    anim_active = CMD_NOP;
+    registers.anim_active = CMD_NOP;
+}
+
+/**
+ * @brief Triangle sweep helper: 0 -> 252 -> 0 over 128 steps
+ */
+static uint8_t anim_triangle(uint16_t step) {
+    return (step < 64) ? (uint8_t)(step * 4) : (uint8_t)((127 - step) * 4);
+}
+
+void update_animations() {
+    if (anim_active == CMD_NOP) {
+        return;
+    }
+
+    // VU and backlight sweeps run 128 steps (1.28s up/down); the tape motor
+    // runs forward at half speed for 100 ticks (1s) then stops.
+    uint16_t duration = 128;
+
+    switch (anim_active) {
+        case CMD_TEST_VU_LEFT:
+            registers.vu_left = anim_triangle(anim_step);
+            break;
+        case CMD_TEST_VU_RIGHT:
+            registers.vu_right = anim_triangle(anim_step);
+            break;
+        case CMD_TEST_VU_BOTH:
+            registers.vu_left = anim_triangle(anim_step);
+            registers.vu_right = anim_triangle(anim_step);
+            break;
+        case CMD_TEST_BACKLIGHT:
+            registers.backlight = anim_triangle(anim_step);
+            break;
+        case CMD_TEST_TAPE_MOTOR:
+            registers.tape_speed = 128;
+            registers.tape_direction = TAPE_DIR_FORWARD;
+            duration = 100;
+            break;
+        case CMD_TEST_ALL:
+            registers.vu_left = anim_triangle(anim_step);
+            registers.vu_right = anim_triangle(anim_step);
+            registers.backlight = anim_triangle(anim_step);
+            registers.tape_speed = 128;
+            registers.tape_direction = TAPE_DIR_FORWARD;
+            break;
+        default:
+            anim_active = CMD_NOP;
+            registers.anim_active = CMD_NOP;
+            return;
+    }
+
+    anim_step++;
+    if (anim_step >= duration) {
+        anim_finish();
+    }
+}
+
+/**
+ * @brief Write a PWM duty cycle only if it differs from the last write
+ *
+ * update_pwm_outputs() runs every tick; this keeps idle outputs from being
+ * reprogrammed 100 times a second. Writes program the slice compare
+ * register directly - a single register store instead of the analogWrite
+ * path, which revalidates pin setup and recalculates the slice config on
+ * every call.
+ */
+static void pwm_write_cached(uint8_t pin, uint8_t level) {
+    if (pwm_last_level[pin] != level) {
+        pwm_last_level[pin] = level;
+        // Scale the 8-bit level to the 10-bit counter; 255 = fully on
+        uint16_t duty = (level == 255) ? (PWM_COUNTER_WRAP + 1)
+                                       : ((uint16_t)level << 2);
+        pwm_set_gpio_level(pin, duty);
+    }
+}
+
+/**
+ * @brief Expand a Q8.8 needle level to a 12-bit duty via the calibration LUT
+ *
+ * The integer byte indexes the table and the fractional byte interpolates
+ * to the next entry, so the slew stage's sub-8-bit steps actually reach
+ * the coil instead of being truncated away.
+ */
+static uint16_t vu_duty_from_q8(uint16_t level_q8) {
+    uint8_t idx = level_q8 >> 8;
+    uint16_t base = vu_cal_lut[idx];
+    uint16_t next = (idx < 255) ? vu_cal_lut[idx + 1] : (VU_PWM_WRAP + 1);
+    uint8_t frac = level_q8 & 0xFF;
+    return base + (uint16_t)(((uint32_t)(next - base) * frac) >> 8);
+}
+
+/**
+ * @brief Write a VU needle level, cached like pwm_write_cached but in Q8.8
+ */
+static void vu_pwm_write(uint8_t pin, uint16_t level_q8) {
+    if (pwm_last_level[pin] != level_q8) {
+        pwm_last_level[pin] = level_q8;
+        pwm_set_gpio_level(pin, vu_duty_from_q8(level_q8));
+    }
+}
+
+/**
+ * @brief Program the VU slice dividers from REG_CONFIG_VU_FREQ
+ *
+ * The register is the carrier frequency in kHz, clamped to what the
+ * 12-bit counter reaches within the clock divider (1-32kHz at 133MHz).
+ * Raising it above ~16kHz puts the carrier beyond coil audibility.
+ */
+static void vu_pwm_apply_freq(void) {
+    uint32_t khz = registers.config_vu_freq;
+    if (khz < 1) khz = 1;
+    if (khz > VU_PWM_FREQ_MAX_KHZ) khz = VU_PWM_FREQ_MAX_KHZ;
+
+    float div = (float)F_CPU / ((VU_PWM_WRAP + 1) * (float)(khz * 1000));
+    pwm_set_clkdiv(slice_vu_left, div);
+    pwm_set_clkdiv(slice_vu_right, div);
+    vu_freq_cfg_cached = registers.config_vu_freq;
+}
+
+/**
+ * @brief Move a slewed level toward its target, bounded by rate per call
+ */
+static uint16_t slew_toward(uint16_t level_q8, uint16_t target_q8, uint16_t rate_q8) {
+    if (rate_q8 == 0) {
+        return target_q8;  // Slew limiting disabled
+    }
+    if (target_q8 > level_q8) {
+        uint16_t diff = target_q8 - level_q8;
+        return level_q8 + (diff < rate_q8 ? diff : rate_q8);
+    } else {
+        uint16_t diff = level_q8 - target_q8;
+        return level_q8 - (diff < rate_q8 ? diff : rate_q8);
+    }
+}
+
+void update_vu_slew() {
+    // REG_CONFIG_VU_SLEW is in 1/4 count units per 1ms tick; Q8.8 scale is
+    // therefore config << 6. Runs at 1kHz from loop1, so a 30-50Hz host
+    // stream still produces continuous needle motion.
+    uint16_t rate_q8 = (uint16_t)registers.config_vu_slew << 6;
+
+    vu_slew_left_q8 = slew_toward(vu_slew_left_q8, vu_target_left_q8, rate_q8);
+    vu_slew_right_q8 = slew_toward(vu_slew_right_q8, vu_target_right_q8, rate_q8);
+
+    // The duty cache makes the unchanged case a compare, so driving the
+    // pins from here costs nothing when the needle is at rest. Full Q8.8
+    // resolution goes to the 12-bit slices - no truncation to 8 bits.
+    vu_pwm_write(PIN_VU_LEFT_IN1, vu_slew_left_q8);
+    vu_pwm_write(PIN_VU_RIGHT_IN1, vu_slew_right_q8);
+}
+
+/**
+ * @brief Advance one channel's peak-hold envelope by one tick
+ *
+ * The envelope latches at the ballistics output, holds for
+ * REG_CONFIG_PEAK_HOLD 10ms units, then falls REG_CONFIG_PEAK_DECAY counts
+ * per tick until the live level catches it again.
+ *
+ * @return The level to drive the needle with (max of live and envelope)
+ */
+static uint8_t vu_peak_step(uint8_t level, uint8_t *peak, uint8_t *hold_ticks) {
+    if (level >= *peak) {
+        *peak = level;
+        *hold_ticks = registers.config_peak_hold;
+    } else if (*hold_ticks > 0) {
+        (*hold_ticks)--;
+    } else {
+        uint8_t decay = registers.config_peak_decay;
+        *peak = (*peak > decay) ? (uint8_t)(*peak - decay) : 0;
+    }
+    return (*peak > level) ? *peak : level;
+}
+
+/**
+ * @brief Walk the tape motor drive one tick toward its targets
+ *
+ * Speed moves toward REG_TAPE_SPEED by REG_CONFIG_TAPE_ACCEL counts per
+ * tick. A direction change - including into BRAKE - first ramps the old
+ * direction down through zero, so the mechanism is never reversed or
+ * locked while turning at speed.
+ */
+static void update_tape_ramp(void) {
+    uint8_t accel = registers.config_tape_accel;
+    // A parked system steers the ramp to a stop without touching the
+    // host's registers, so drive resumes from them when the host returns
+    uint8_t target_dir = failsafe_active ? TAPE_DIR_STOP
+                                         : registers.tape_direction;
+    bool driving = (tape_actual_direction == TAPE_DIR_FORWARD ||
+                    tape_actual_direction == TAPE_DIR_REVERSE);
+    uint8_t target_speed = (target_dir == TAPE_DIR_FORWARD ||
+                            target_dir == TAPE_DIR_REVERSE)
+                               ? registers.tape_speed : 0;
+
+    if (accel == 0) {
+        // Ramping disabled - legacy instant-apply behavior
+        tape_actual_direction = target_dir;
+        tape_actual_speed = target_speed;
+        return;
+    }
+
+    if (tape_actual_direction != target_dir) {
+        if (driving && tape_actual_speed > 0) {
+            // Ramp down in the old direction before switching
+            tape_actual_speed = (tape_actual_speed > accel)
+                                    ? (uint8_t)(tape_actual_speed - accel) : 0;
+            return;
         }
-    } else if (reg_addr == REG_INPUT_CHANGED_HIGH) {
-        registers.input_changed_high = 0;
-        if (registers.input_changed_low == 0) {
-            registers.status &= ~STATUS_INPUT_CHANGED;
+        tape_actual_direction = target_dir;
+    }
+
+    if (tape_actual_speed < target_speed) {
+        uint8_t diff = target_speed - tape_actual_speed;
+        tape_actual_speed += (diff < accel) ? diff : accel;
+    } else if (tape_actual_speed > target_speed) {
+        uint8_t diff = tape_actual_speed - target_speed;
+        tape_actual_speed -= (diff < accel) ? diff : accel;
+    }
+}
+
+/**
+ * @brief Integrate the actual drive into the virtual tape counter (100Hz)
+ *
+ * One odometer count is one speed count for one 10ms tick, so full speed
+ * forward accumulates 25,500 counts per second. Runs every tick, including
+ * with the motor disabled, so a staged reset is never left hanging.
+ */
+static void update_tape_odometer(void) {
+    if (odometer_reset_pending) {
+        odometer_reset_pending = false;
+        tape_odometer = 0;
+    }
+
+    if (tape_actual_speed > 0) {
+        if (tape_actual_direction == TAPE_DIR_FORWARD) {
+            tape_odometer += tape_actual_speed;
+        } else if (tape_actual_direction == TAPE_DIR_REVERSE) {
+            tape_odometer -= tape_actual_speed;
         }
-    } else if (reg_addr == REG_ENCODER_DELTA) {
-        registers.status &= ~STATUS_ENCODER_CHANGED;
     }
 
+    uint32_t odo = (uint32_t)tape_odometer;
+    registers.tape_odo_0 = odo & 0xFF;
+    registers.tape_odo_1 = (odo >> 8) & 0xFF;
+    registers.tape_odo_2 = (odo >> 16) & 0xFF;
+    registers.tape_odo_3 = (odo >> 24) & 0xFF;
+}
+
+/**
+ * @brief Host liveness failsafe (100Hz)
+ *
+ * Parks the outputs when the host has been silent longer than the
+ * configured window: VU targets drop to zero so the slew engine glides
+ * the needles down, and the tape ramp is steered to a stop. The first
+ * transaction after the outage refreshes the activity stamp, so normal
+ * drive resumes on the next tick - no reboot, no visible gap.
+ */
+static void update_failsafe(void) {
+    uint8_t window = registers.config_host_timeout;  // 100ms units
+    if (window == 0) {
+        failsafe_active = false;
+        return;
+    }
+
+    uint32_t silent_ms = millis() - i2c_last_activity_ms;
+    bool timed_out = silent_ms > (uint32_t)window * 100;
+
+    if (timed_out && !failsafe_active) {
+        failsafe_active = true;
+        registers.error |= ERROR_HOST_TIMEOUT;  // Latched record of the event
+        log_msg(LOG_CAT_CTRL, LOG_ERROR,
+                "failsafe: host silent %lums, outputs parked",
+                (unsigned long)silent_ms);
+    } else if (!timed_out && failsafe_active) {
+        failsafe_active = false;
+        log_msg(LOG_CAT_CTRL, LOG_INFO, "failsafe: host traffic resumed");
+    }
+}
+
+/**
+ * @brief Advance the backlight idle dimming engine (100Hz)
+ *
+ * After REG_CONFIG_IDLE_TIMEOUT seconds without user activity the cap
+ * ramps down to REG_CONFIG_IDLE_LEVEL (~1.3s full-scale fade); the first
+ * input edge, encoder detent or button press zeroes idle_ticks, and full
+ * brightness is back by the end of that same tick - no host round trip.
+ */
+static void update_idle_dimming(void) {
+    uint8_t timeout_s = registers.config_idle_timeout;
+    if (timeout_s == 0) {
+        idle_dim_cap = 255;  // Engine disabled, host drives dimming
+        idle_ticks = 0;
+        return;
+    }
+
+    idle_ticks++;
+    uint32_t threshold =
+        (uint32_t)timeout_s * (SCHEDULER_TICK_HZ / SCHEDULER_TICKS_PER_UPDATE);
+    if (idle_ticks < threshold) {
+        idle_dim_cap = 255;  // Active (or just woken): no cap
+        return;
+    }
+    idle_ticks = threshold;  // Hold so the counter cannot wrap back awake
+
+    uint8_t floor_level = registers.config_idle_level;
+    if (idle_dim_cap > floor_level) {
+        uint8_t remaining = idle_dim_cap - floor_level;
+        idle_dim_cap -= (remaining < 2) ? remaining : 2;
+    }
+}
+
+/**
+ * @brief Compute the backlight duty for the current mode
+ *
+ * MANUAL passes REG_BACKLIGHT through unchanged. AUTO follows the louder VU
+ * channel through an EMA (~160ms settle); PULSE breathes on a 5.12s triangle.
+ * Both effects treat REG_BACKLIGHT as the peak brightness and map the result
+ * through the gamma LUT so low levels don't band. The idle dimming cap is
+ * applied in the brightness domain (before gamma), so it dims but never
+ * brightens what the mode produced.
+ */
+static uint8_t backlight_effect_level(void) {
+    uint8_t effect;
+
+    switch (registers.backlight_mode) {
+        case BACKLIGHT_MODE_AUTO: {
+            // EMA of the louder channel: level += (target - level) / 16
+            uint16_t target_q8 = (vu_level_left_q8 > vu_level_right_q8)
+                                     ? vu_level_left_q8 : vu_level_right_q8;
+            int32_t diff = (int32_t)target_q8 - (int32_t)backlight_auto_level_q8;
+            backlight_auto_level_q8 = (uint16_t)((int32_t)backlight_auto_level_q8 + (diff >> 4));
+            effect = backlight_auto_level_q8 >> 8;
+            break;
+        }
+        case BACKLIGHT_MODE_PULSE:
+            // 512-step triangle at 100Hz = 5.12s breathing cycle
+            backlight_pulse_phase = (backlight_pulse_phase + 1) & 0x1FF;
+            effect = (backlight_pulse_phase < 256)
+                         ? (uint8_t)backlight_pulse_phase
+                         : (uint8_t)(511 - backlight_pulse_phase);
+            break;
+        case BACKLIGHT_MODE_MANUAL:
+        default:
+            // Host drives the raw duty directly, as before
+            return (registers.backlight < idle_dim_cap)
+                       ? registers.backlight : idle_dim_cap;
+    }
+
+    // Scale by REG_BACKLIGHT as the peak, then linearize
+    uint8_t scaled = (uint8_t)(((uint16_t)effect * registers.backlight) / 255);
+    if (scaled > idle_dim_cap) {
+        scaled = idle_dim_cap;
+    }
+    return backlight_gamma_lut[scaled];
+}
+
+void update_pwm_outputs() {
+    // Check if outputs are enabled
+    bool vu_enabled = registers.control & CTRL_VU_ENABLE;
+    bool backlight_enabled = registers.control & CTRL_BACKLIGHT_ENABLE;
+    bool tape_enabled = registers.control & CTRL_TAPE_ENABLE;
+
+    // Update VU meters (ballistics-filtered levels drive the needles)
+    if (vu_enabled && registers.vu_mode != VU_MODE_OFF && !failsafe_active) {
+        uint8_t left = vu_level_left_q8 >> 8;
+        uint8_t right = vu_level_right_q8 >> 8;
+
+        // Peak hold runs here so the envelope advances exactly once per
+        // tick; anywhere else the timing would drift with host polling
+        if (registers.vu_mode == VU_MODE_PEAK_HOLD) {
+            left = vu_peak_step(left, &vu_peak_left, &vu_peak_hold_left_ticks);
+            right = vu_peak_step(right, &vu_peak_right, &vu_peak_hold_right_ticks);
+        } else {
+            vu_peak_left = 0;   // Don't carry a stale latch into the mode
+            vu_peak_right = 0;
+        }
+
+        // Track carrier frequency changes from the host
+        if (registers.config_vu_freq != vu_freq_cfg_cached) {
+            vu_pwm_apply_freq();
+        }
+
+        // Hand the levels to the 1kHz slew stage, which owns the IN1 pins
+        vu_target_left_q8 = (uint16_t)left << 8;
+        vu_target_right_q8 = (uint16_t)right << 8;
+        vu_pwm_write(PIN_VU_LEFT_IN2, 0);
+        vu_pwm_write(PIN_VU_RIGHT_IN2, 0);
+        registers.status |= STATUS_VU_ACTIVE;
+    } else {
+        vu_target_left_q8 = 0;
+        vu_target_right_q8 = 0;
+        vu_pwm_write(PIN_VU_LEFT_IN2, 0);
+        vu_pwm_write(PIN_VU_RIGHT_IN2, 0);
+        registers.status &= ~STATUS_VU_ACTIVE;
+    }
+
+    // Update backlight
+    if (backlight_enabled && registers.backlight_mode != BACKLIGHT_MODE_OFF) {
+        pwm_write_cached(PIN_BACKLIGHT_IN1, backlight_effect_level());
+        pwm_write_cached(PIN_BACKLIGHT_IN2, 0);
+        registers.status |= STATUS_BACKLIGHT_ON;
+    } else {
+        pwm_write_cached(PIN_BACKLIGHT_IN1, 0);
+        pwm_write_cached(PIN_BACKLIGHT_IN2, 0);
+        registers.status &= ~STATUS_BACKLIGHT_ON;
+    }
+
+    // Update tape motor (ramped drive, not the raw registers)
+    if (tape_enabled && registers.tape_mode != TAPE_MODE_OFF) {
+        update_tape_ramp();
+        switch (tape_actual_direction) {
+            case TAPE_DIR_FORWARD:
+                pwm_write_cached(PIN_TAPE_MOTOR_IN1, tape_actual_speed);
+                pwm_write_cached(PIN_TAPE_MOTOR_IN2, 0);
+                registers.status |= STATUS_TAPE_RUNNING;
+                break;
+            case TAPE_DIR_REVERSE:
+                pwm_write_cached(PIN_TAPE_MOTOR_IN1, 0);
+                pwm_write_cached(PIN_TAPE_MOTOR_IN2, tape_actual_speed);
+                registers.status |= STATUS_TAPE_RUNNING;
+                break;
+            case TAPE_DIR_BRAKE:
+                // Only reached after the ramp has taken speed to zero
+                pwm_write_cached(PIN_TAPE_MOTOR_IN1, 255);
+                pwm_write_cached(PIN_TAPE_MOTOR_IN2, 255);
+                registers.status &= ~STATUS_TAPE_RUNNING;
+                break;
+            case TAPE_DIR_STOP:
+            default:
+                pwm_write_cached(PIN_TAPE_MOTOR_IN1, 0);
+                pwm_write_cached(PIN_TAPE_MOTOR_IN2, 0);
+                registers.status &= ~STATUS_TAPE_RUNNING;
+                break;
+        }
+    } else {
+        // Disable is an immediate cut, not a ramp
+        tape_actual_speed = 0;
+        tape_actual_direction = TAPE_DIR_STOP;
+        pwm_write_cached(PIN_TAPE_MOTOR_IN1, 0);
+        pwm_write_cached(PIN_TAPE_MOTOR_IN2, 0);
+        registers.status &= ~STATUS_TAPE_RUNNING;
+    }
+
+    // Integrate the drive applied this tick into the virtual tape counter
+    update_tape_odometer();
+}
+
+// ============================================================================
+// Benchmark
+// ============================================================================
+
+/**
+ * @brief Measure what this build can sustain (CMD_BENCHMARK)
+ *
+ * Runs on core1 in place of one control tick, so the measured paths see
+ * their real cache and bus contention state. Results land in the benchmark
+ * result block (0xBA-0xBF):
+ *  - register write throughput, in kops/s, over 1000 calls
+ *  - one full control cycle (input scan, encoder, PWM update), in us
+ *  - tick budget left after such a cycle, in percent
+ */
+static void run_benchmark(void) {
+    // The benchmark runs after the tick's closing state_seq++, but it
+    // mutates the bank and core1 state throughout - reopen the seqlock
+    // so core0 never latches a snapshot mid-benchmark
+    state_seq++;
+
+    registers.bench_status = BENCH_RUNNING;
+
+    // Register write path: 1000 writes to a harmless R/W register,
+    // restored afterwards
+    uint8_t saved_vu_left = registers.vu_left;
+    uint32_t t0 = time_us_32();
+    for (uint32_t i = 0; i < 1000; i++) {
+        i2c_register_write(REG_VU_LEFT, (uint8_t)i);
+    }
+    uint32_t write_us = time_us_32() - t0;
+    registers.vu_left = saved_vu_left;
+
+    // 1000 ops in write_us microseconds = 1e6 / write_us kops/s
+    uint16_t kops = write_us > 0 ? (uint16_t)(1000000UL / write_us) : 0xFFFF;
+    registers.bench_write_kops_low = kops & 0xFF;
+    registers.bench_write_kops_high = (kops >> 8) & 0xFF;
+
+    // Full control cycle, exactly as the 100Hz tick runs it. The extra
+    // pass would double-step the tape ramp and double-integrate the
+    // odometer, so the integrators are saved and restored around it
+    uint8_t saved_tape_speed = tape_actual_speed;
+    uint8_t saved_tape_dir = tape_actual_direction;
+    int32_t saved_odometer = tape_odometer;
+    t0 = time_us_32();
+    update_inputs();
+    update_encoder();
+    update_pwm_outputs();
+    uint32_t cycle_us = time_us_32() - t0;
+    tape_actual_speed = saved_tape_speed;
+    tape_actual_direction = saved_tape_dir;
+    tape_odometer = saved_odometer;
+    uint32_t saved_odo = (uint32_t)saved_odometer;
+    registers.tape_odo_0 = saved_odo & 0xFF;
+    registers.tape_odo_1 = (saved_odo >> 8) & 0xFF;
+    registers.tape_odo_2 = (saved_odo >> 16) & 0xFF;
+    registers.tape_odo_3 = (saved_odo >> 24) & 0xFF;
+    if (cycle_us > 0xFFFF) {
+        cycle_us = 0xFFFF;
+    }
+    registers.bench_cycle_us_low = cycle_us & 0xFF;
+    registers.bench_cycle_us_high = (cycle_us >> 8) & 0xFF;
+
+    // Percent of the 10ms tick budget left after one cycle
+    registers.bench_headroom = cycle_us >= 10000
+                                   ? 0 : (uint8_t)(100 - cycle_us / 100);
+
+    registers.bench_status = BENCH_DONE;
+
+    // Close the benchmark's seqlock window before logging
+    state_seq++;
+    log_msg(LOG_CAT_SYS, LOG_INFO, "bench: cycle %luus, headroom %u%%",
+            (unsigned long)cycle_us, registers.bench_headroom);
+}
+
+// ============================================================================
+// I2C Handlers
+// ============================================================================
+
+/**
+ * @brief Record time spent in an I2C handler invocation
+ */
+static void perf_record_i2c(uint32_t start_us) {
+    uint32_t elapsed = time_us_32() - start_us;
+    uint8_t us = elapsed > 255 ? 255 : (uint8_t)elapsed;
+    registers.perf_i2c_us = us;
+    if (us > perf_i2c_max_us) {
+        perf_i2c_max_us = us;
+        registers.perf_i2c_max = us;
+    }
+}
+
+/**
+ * @brief Stage the read response window for the current register pointer
+ *
+ * Fills the prefetch buffer with side-effect-free peeks so the per-byte
+ * request ISR only has to index the buffer. The event FIFO data port is
+ * excluded - its pops are destructive and stay in the request path, where
+ * they are already a plain ring buffer fetch.
+ */
+static void i2c_stage_response(void) {
+    i2c_tx_idx = 0;
+
+    if (current_register == REG_EVENT_FIFO_DATA) {
+        i2c_tx_len = 0;
+        return;
+    }
+
+    for (uint8_t i = 0; i < I2C_TX_WINDOW_SIZE; i++) {
+        i2c_tx_window[i] = i2c_register_peek(current_register + i);
+    }
+    i2c_tx_len = I2C_TX_WINDOW_SIZE;
+
+    // Latch the encoder block when the window covers it. update_encoder()
+    // on core1 rewrites these registers between our peeks, so a window
+    // assembled byte-by-byte could hold a torn 16-bit position. One aligned
+    // 16-bit load of encoder_position cannot tear, and the overlay keeps
+    // position, delta and button from the same instant for the whole
+    // transaction.
+    if (current_register <= REG_ENCODER_BUTTON &&
+        (uint8_t)(current_register + I2C_TX_WINDOW_SIZE) > REG_ENCODER_POS_LOW) {
+        int16_t pos = encoder_position;
+        uint8_t latched[4] = {
+            (uint8_t)(pos & 0xFF),
+            (uint8_t)((pos >> 8) & 0xFF),
+            (uint8_t)registers.encoder_delta,
+            registers.encoder_button
+        };
+        for (uint8_t i = 0; i < 4; i++) {
+            uint8_t reg = REG_ENCODER_POS_LOW + i;
+            if (reg >= current_register &&
+                (uint8_t)(reg - current_register) < I2C_TX_WINDOW_SIZE) {
+                i2c_tx_window[reg - current_register] = latched[i];
+            }
+        }
+    }
+
+    // Same latch for the live odometer block: one aligned 32-bit load
+    // cannot tear, so all four bytes come from the same instant
+    if (current_register <= REG_TAPE_ODO_3 &&
+        (uint8_t)(current_register + I2C_TX_WINDOW_SIZE) > REG_TAPE_ODO_0) {
+        uint32_t odo = (uint32_t)tape_odometer;
+        for (uint8_t i = 0; i < 4; i++) {
+            uint8_t reg = REG_TAPE_ODO_0 + i;
+            if (reg >= current_register &&
+                (uint8_t)(reg - current_register) < I2C_TX_WINDOW_SIZE) {
+                i2c_tx_window[reg - current_register] = (odo >> (8 * i)) & 0xFF;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Dispatch the pending write burst to the register bank
+ *
+ * Runs from core0's idle loop with the I2C interrupt masked, or inline
+ * from an ISR when a follow-up transaction arrives before the idle loop
+ * got a turn (which preserves write ordering in all cases).
+ */
+static void i2c_rx_flush(void) {
+    uint8_t reg = i2c_rx_reg;
+    for (uint8_t i = 0; i < i2c_rx_count; i++) {
+        i2c_register_write(reg, i2c_rx_mailbox[i]);
+        // Data ports consume whole bursts without auto-increment
+        if (reg != REG_VU_FIFO_DATA && reg != REG_VU_PAIR_DATA) {
+            reg++;
+        }
+    }
+    i2c_rx_count = 0;
+}
+
+void i2c_receive_handler(int byte_count) {
+    uint32_t start_us = time_us_32();
+    i2c_last_activity_ms = millis();  // Host liveness stamp
+
+    if (byte_count < 1) return;
+
+    // A burst the idle loop hasn't dispatched yet must land first
+    if (i2c_rx_count > 0) {
+        i2c_rx_flush();
+    }
+
+    // First byte is register address
+    current_register = Wire1.read();
+    byte_count--;
+
+    if (byte_count > 0) {
+        // Write burst: copy to the mailbox and let the idle loop dispatch.
+        // Only the register pointer is computed here, so subsequent reads
+        // address the right window.
+        i2c_rx_reg = current_register;
+        uint8_t n = 0;
+        while (byte_count > 0 && n < I2C_BUFFER_SIZE) {
+            i2c_rx_mailbox[n++] = Wire1.read();
+            byte_count--;
+        }
+        i2c_rx_count = n;
+
+        uint8_t reg = i2c_rx_reg;
+        for (uint8_t i = 0; i < n; i++) {
+            if (reg != REG_VU_FIFO_DATA && reg != REG_VU_PAIR_DATA) {
+                reg++;
+            }
+        }
+        current_register = reg;
+
+        // Invalidate the staged response; a read that follows will restage
+        // after the mailbox has been flushed
+        i2c_tx_len = 0;
+        i2c_tx_idx = 0;
+    } else {
+        // Pure address set - a read follows, so prefetch the response now,
+        // while the master is still turning the bus around
+        i2c_stage_response();
+    }
+
+    perf_record_i2c(start_us);
+}
+
+void i2c_request_handler() {
+    uint32_t start_us = time_us_32();
+    i2c_last_activity_ms = millis();  // Host liveness stamp
+
+    // Writes still sitting in the mailbox must apply before we serve a
+    // read, or the master could read back stale values
+    if (i2c_rx_count > 0) {
+        i2c_rx_flush();
+        i2c_stage_response();
+    }
+
+    // Event FIFO data port pops straight from the ring buffer
+    if (current_register == REG_EVENT_FIFO_DATA) {
+        Wire1.write(event_fifo_pop_byte());
+        perf_record_i2c(start_us);
+        return;
+    }
+
+    // Restage if the master read past the window (or never set an address)
+    if (i2c_tx_idx >= i2c_tx_len) {
+        i2c_stage_response();
+    }
+
+    // Pure buffer fetch, then apply clear-on-read effects for the byte the
+    // master actually consumed
+    uint8_t served = i2c_tx_window[i2c_tx_idx++];
+    Wire1.write(served);
+    i2c_register_consume(current_register, served);
+    current_register++;
+
+    perf_record_i2c(start_us);
+}
+
+// ============================================================================
+// Config Persistence
+// ============================================================================
+
+/**
+ * @brief Get a pointer to a journal slot via the XIP window
+ */
+static const ConfigRecord *config_slot(uint slot) {
+    uintptr_t addr = XIP_BASE + CONFIG_FLASH_OFFSET + slot * CONFIG_SLOT_SIZE;
+    return (const ConfigRecord *)addr;
+}
+
+static uint8_t config_checksum(const uint8_t *payload) {
+    uint8_t sum = 0;
+    for (uint i = 0; i < CONFIG_PAYLOAD_SIZE; i++) {
+        sum ^= payload[i];
+    }
+    return sum;
+}
+
+/**
+ * @brief Find the newest valid journal record
+ *
+ * Slots are written in order into erased space, so the highest-index valid
+ * slot is the most recent save.
+ *
+ * @return Slot index, or -1 if no valid record exists
+ */
+static int config_find_latest(void) {
+    int latest = -1;
+    for (uint i = 0; i < CONFIG_SLOT_COUNT; i++) {
+        const ConfigRecord *rec = config_slot(i);
+        if (rec->magic == CONFIG_MAGIC && rec->version == CONFIG_VERSION &&
+            rec->checksum == config_checksum(rec->payload)) {
+            latest = (int)i;
+        }
+    }
+    return latest;
+}
+
+/**
+ * @brief Load the persisted config block into registers 0x70-0x7F
+ *
+ * Reads through XIP only, so this is safe to call from any context,
+ * including i2c_registers_init() at boot.
+ *
+ * @return true if a valid record was found and applied
+ */
+static bool config_load(void) {
+    int slot = config_find_latest();
+    if (slot < 0) {
+        return false;  // Journal empty or corrupt - keep compiled defaults
+    }
+
+    uint8_t *reg_ptr = (uint8_t *)&registers;
+    memcpy(&reg_ptr[REG_CONFIG_VU_FREQ], config_slot(slot)->payload,
+           CONFIG_PAYLOAD_SIZE);
+    log_msg(LOG_CAT_CONFIG, LOG_INFO, "config: loaded journal slot %d", slot);
+    return true;
+}
+
+/**
+ * @brief Append the current config block to the flash journal
+ *
+ * Programs the next erased slot; the sector is only erased when all slots
+ * have been consumed. Runs on core0 with core1 parked and interrupts off,
+ * since flash operations stall all XIP code fetches.
+ */
+static void config_save(void) {
+    // Find the first erased slot (magic byte still 0xFF)
+    int slot = -1;
+    for (uint i = 0; i < CONFIG_SLOT_COUNT; i++) {
+        if (config_slot(i)->magic == 0xFF) {
+            slot = (int)i;
+            break;
+        }
+    }
+
+    // Build the page image in RAM before touching flash
+    static uint8_t page[CONFIG_SLOT_SIZE];
+    memset(page, 0xFF, sizeof(page));
+    ConfigRecord *rec = (ConfigRecord *)page;
+    rec->magic = CONFIG_MAGIC;
+    rec->version = CONFIG_VERSION;
+    rec->reserved = 0xFF;
+    uint8_t *reg_ptr = (uint8_t *)&registers;
+    memcpy(rec->payload, &reg_ptr[REG_CONFIG_VU_FREQ], CONFIG_PAYLOAD_SIZE);
+    rec->checksum = config_checksum(rec->payload);
+
+    bool recycled = (slot < 0);
+
+    rp2040.idleOtherCore();
+    uint32_t irq_state = save_and_disable_interrupts();
+    if (slot < 0) {
+        // Journal full - reclaim the sector and start over
+        flash_range_erase(CONFIG_FLASH_OFFSET, FLASH_SECTOR_SIZE);
+        slot = 0;
+    }
+    flash_range_program(CONFIG_FLASH_OFFSET + (uint)slot * CONFIG_SLOT_SIZE,
+                        page, CONFIG_SLOT_SIZE);
+    restore_interrupts(irq_state);
+    rp2040.resumeOtherCore();
+
+    if (recycled) {
+        log_msg(LOG_CAT_CONFIG, LOG_INFO, "config: journal full, sector recycled");
+    }
+    log_msg(LOG_CAT_CONFIG, LOG_INFO, "config: saved to slot %d", slot);
+}
+
+/**
+ * @brief Erase the config journal (CMD_FACTORY_RESET)
+ */
+static void config_factory_erase(void) {
+    rp2040.idleOtherCore();
+    uint32_t irq_state = save_and_disable_interrupts();
+    flash_range_erase(CONFIG_FLASH_OFFSET, FLASH_SECTOR_SIZE);
+    restore_interrupts(irq_state);
+    rp2040.resumeOtherCore();
+    log_msg(LOG_CAT_CONFIG, LOG_INFO, "config: factory reset, journal erased");
+}
+
+// ============================================================================
+// Register Functions
+// ============================================================================
+
+void i2c_registers_init() {
+    memset(&registers, 0, sizeof(registers));
+
+    // Initialize device info
+    registers.device_id = DEVICE_ID;
+    registers.fw_ver_major = FIRMWARE_VERSION_MAJOR;
+    registers.fw_ver_minor = FIRMWARE_VERSION_MINOR;
+    registers.fw_ver_patch = FIRMWARE_VERSION_PATCH;
+
+    // Initialize default values
+    registers.control = CTRL_ENABLE;
+    registers.status = STATUS_READY;
+    registers.vu_mode = VU_MODE_NORMAL;
+    registers.backlight = 128;
+    registers.backlight_mode = BACKLIGHT_MODE_MANUAL;
+    registers.tape_direction = TAPE_DIR_STOP;
+    registers.tape_mode = TAPE_MODE_MANUAL;
+    registers.input_status_low = 0xFF;
+    registers.input_status_high = 0x0F;
+    registers.config_vu_freq = 1;
+    registers.config_debounce = INPUT_DEBOUNCE_MS;
+    registers.config_vu_attack = VU_BALLISTICS_DEFAULT;
+    registers.config_vu_release = VU_BALLISTICS_DEFAULT;
+    registers.config_peak_hold = PEAK_HOLD_DEFAULT;
+    registers.config_peak_decay = PEAK_DECAY_DEFAULT;
+    registers.config_vu_slew = VU_SLEW_DEFAULT;
+    registers.config_tape_accel = TAPE_ACCEL_DEFAULT;
+    registers.config_log_level = LOG_LEVEL_DEFAULT;
+    registers.config_idle_timeout = IDLE_TIMEOUT_DEFAULT;
+    registers.config_idle_level = IDLE_LEVEL_DEFAULT;
+    registers.config_host_timeout = HOST_TIMEOUT_DEFAULT;
+    registers.vu_fifo_space = VU_FIFO_DEPTH - 1;
+
+    // Overlay persisted config so the panel comes up calibrated before the
+    // host has even booted; defaults above stand if the journal is empty
+    config_load();
+}
+
+void i2c_update_snapshot() {
+    // Latch the live registers into the snapshot block. The seqlock retry
+    // guards against core1 mutating the bank mid-copy (the copy is redone
+    // if the sequence moved); masking interrupts guards the other side -
+    // an I2C read staging from a half-copied snapshot block on this core.
+    uint32_t s1, s2;
+    do {
+        do {
+            s1 = state_seq;
+        } while (s1 & 1);  // Core1 mid-tick; ticks take ~100us of the 10ms
+
+        noInterrupts();
+        registers.snap_status = registers.status;
+        registers.snap_error = registers.error;
+        registers.snap_input_status_low = registers.input_status_low;
+        registers.snap_input_status_high = registers.input_status_high;
+        registers.snap_input_changed_low = registers.input_changed_low;
+        registers.snap_input_changed_high = registers.input_changed_high;
+        registers.snap_encoder_pos_low = registers.encoder_pos_low;
+        registers.snap_encoder_pos_high = registers.encoder_pos_high;
+        registers.snap_encoder_delta = registers.encoder_delta;
+        registers.snap_encoder_button = registers.encoder_button;
+        registers.snap_tick_low = update_tick & 0xFF;
+        registers.snap_tick_high = (update_tick >> 8) & 0xFF;
+        registers.snap_odo_0 = registers.tape_odo_0;
+        registers.snap_odo_1 = registers.tape_odo_1;
+        registers.snap_odo_2 = registers.tape_odo_2;
+        registers.snap_odo_3 = registers.tape_odo_3;
+        interrupts();
+
+        s2 = state_seq;
+    } while (s1 != s2);
+}
+
+// ----------------------------------------------------------------------------
+// Register descriptor table
+//
+// Access rules and side effects for the whole 8-bit address space, built at
+// compile time from the REG_* definitions so read/write dispatch is a single
+// table lookup instead of an if/else chain that grows with every feature.
+// The table runs in interrupt context; keeping it branch-light keeps the
+// handler cost flat as registers are added. 256 entries cost ~3KB of flash.
+// ----------------------------------------------------------------------------
+
+#define REGF_READ_ONLY  0x01  // Host writes rejected with ERROR_INVALID_REG
+#define REGF_NO_STORE   0x02  // Data port: write handler replaces the bank store
+
+typedef void (*RegConsumeFn)(uint8_t);    // Clear-on-read side effect (served byte)
+typedef bool (*RegWriteFn)(uint8_t);      // Post-store (or store-replacing) action
+
+struct RegDescriptor {
+    uint8_t flags;
+    RegConsumeFn on_consume;
+    RegWriteFn on_write;
+};
+
+// The changed flags and status bits are core1-owned, so the clear-on-read
+// side effects are staged here and applied by core1 at its next tick
+// boundary (inside the seqlock) - same pattern as CTRL_RESET_ENCODER.
+// The acknowledge carries the byte the master was served (live or snapshot
+// copy), so only the bits the host actually saw are cleared; it lands
+// within one 10ms tick.
+static void reg_consume_changed_low(uint8_t served) {
+    changed_low_ack_mask |= served;
+}
+
+static void reg_consume_changed_high(uint8_t served) {
+    changed_high_ack_mask |= served;
+}
+
+static void reg_consume_encoder_delta(uint8_t served) {
+    (void)served;
+    encoder_ack_pending = true;
+}
+
+// Reading the high byte of a MAX performance counter rearms it
+static void reg_consume_perf_tick_max(uint8_t served) {
+    (void)served;
+    perf_tick_max_us = 0;
+    registers.perf_tick_max_low = 0;
+    registers.perf_tick_max_high = 0;
+}
+
+static void reg_consume_perf_jitter_max(uint8_t served) {
+    (void)served;
+    perf_jitter_max_us = 0;
+    registers.perf_jitter_max_low = 0;
+    registers.perf_jitter_max_high = 0;
+}
+
+static void reg_consume_perf_i2c_max(uint8_t served) {
+    (void)served;
+    perf_i2c_max_us = 0;
+    registers.perf_i2c_max = 0;
+}
+
+static bool reg_write_control(uint8_t value) {
+    if (value & CTRL_RESET_ENCODER) {
+        // Encoder state is core1-owned; stage the reset and let core1
+        // apply it at its next tick boundary (inside the seqlock)
+        encoder_reset_pending = true;
+        registers.control &= ~CTRL_RESET_ENCODER;
+    }
+    if (value & CTRL_CLEAR_INPUTS) {
+        // Change flags are core1-owned; staged like the encoder reset
+        input_clear_pending = true;
+        registers.control &= ~CTRL_CLEAR_INPUTS;
+    }
+    if (value & CTRL_LOAD_CONFIG) {
+        // XIP read only - safe in the I2C handler
+        config_load();
+        registers.control &= ~CTRL_LOAD_CONFIG;
+    }
+    if (value & CTRL_SAVE_CONFIG) {
+        // Flash programming stalls XIP; defer to core0's idle loop. The
+        // bit stays set until the save completes so the host can poll.
+        config_save_pending = true;
+    }
+    return true;
+}
+
+static bool reg_write_command(uint8_t value) {
+    return i2c_execute_command(value);
+}
+
+static bool reg_write_vu_fifo_data(uint8_t value) {
+    vu_fifo_push_byte(value);
+    return true;
+}
+
+static bool reg_write_vu_pair_data(uint8_t value) {
+    vu_pair_push_byte(value);
+    return true;
+}
+
+struct RegTable {
+    RegDescriptor entry[256];
+};
+
+static constexpr RegTable make_reg_table() {
+    RegTable t{};
+
+    // Device info block is immutable
+    for (uint16_t r = REG_DEVICE_ID; r <= REG_FIRMWARE_VER_PATCH; r++) {
+        t.entry[r].flags |= REGF_READ_ONLY;
+    }
+
+    // Snapshot block is latched by the update loop, never host-written
+    for (uint16_t r = REG_SNAPSHOT_BASE; r <= REG_SNAPSHOT_END; r++) {
+        t.entry[r].flags |= REGF_READ_ONLY;
+    }
+
+    // Animation busy byte is maintained by the engine
+    t.entry[REG_ANIM_ACTIVE].flags |= REGF_READ_ONLY;
+
+    // Data ports bypass the bank store
+    t.entry[REG_COMMAND].flags = REGF_NO_STORE;
+    t.entry[REG_COMMAND].on_write = reg_write_command;
+    t.entry[REG_VU_FIFO_DATA].flags = REGF_NO_STORE;
+    t.entry[REG_VU_FIFO_DATA].on_write = reg_write_vu_fifo_data;
+    t.entry[REG_VU_PAIR_DATA].flags = REGF_NO_STORE;
+    t.entry[REG_VU_PAIR_DATA].on_write = reg_write_vu_pair_data;
+
+    // Control register applies its action bits after the store
+    t.entry[REG_CONTROL].on_write = reg_write_control;
+
+    // Clear-on-read flags; the snapshot copies acknowledge the live
+    // accumulators, same as the live registers, so a burst read clears
+    // exactly the changes it saw
+    t.entry[REG_INPUT_CHANGED_LOW].on_consume = reg_consume_changed_low;
+    t.entry[REG_INPUT_CHANGED_HIGH].on_consume = reg_consume_changed_high;
+    t.entry[REG_ENCODER_DELTA].on_consume = reg_consume_encoder_delta;
+    t.entry[REG_SNAPSHOT_CHANGED_LOW].on_consume = reg_consume_changed_low;
+    t.entry[REG_SNAPSHOT_CHANGED_HIGH].on_consume = reg_consume_changed_high;
+    t.entry[REG_SNAPSHOT_ENC_DELTA].on_consume = reg_consume_encoder_delta;
+    t.entry[REG_PERF_TICK_MAX_HIGH].on_consume = reg_consume_perf_tick_max;
+    t.entry[REG_PERF_JITTER_MAX_HIGH].on_consume = reg_consume_perf_jitter_max;
+    t.entry[REG_PERF_I2C_MAX].on_consume = reg_consume_perf_i2c_max;
+
+    return t;
+}
+
+static constexpr RegTable reg_table = make_reg_table();
+
+/**
+ * @brief Read a register value without any side effects
+ *
+ * Used to stage the prefetch window: staged bytes the master never clocks
+ * out must not clear flags or flag errors. The event FIFO data port is not
+ * peekable (pops are destructive) and is handled directly in the request ISR.
+ */
+static uint8_t i2c_register_peek(uint8_t reg_addr) {
+    if (reg_addr >= sizeof(I2CRegisterBank)) {
+        return 0xFF;
+    }
+
+    uint8_t *reg_ptr = (uint8_t*)&registers;
+    return reg_ptr[reg_addr];
+}
+
+/**
+ * @brief Apply the clear-on-read side effects for a consumed register
+ *
+ * Called only for bytes the master actually clocked out, so flags survive
+ * a prefetch that runs past what the host asked for.
+ */
+static void i2c_register_consume(uint8_t reg_addr, uint8_t served) {
+    if (reg_addr >= sizeof(I2CRegisterBank)) {
+        registers.error |= ERROR_INVALID_REG;
+        return;
+    }
+
+    RegConsumeFn fn = reg_table.entry[reg_addr].on_consume;
+    if (fn) {
+        fn(served);
+    }
+}
+
+uint8_t i2c_register_read(uint8_t reg_addr) {
+    // Event FIFO data port streams queued events byte-by-byte
+    if (reg_addr == REG_EVENT_FIFO_DATA) {
+        return event_fifo_pop_byte();
+    }
+
+    uint8_t value = i2c_register_peek(reg_addr);
+    i2c_register_consume(reg_addr, value);
     return value;
 }
 
 bool i2c_register_write(uint8_t reg_addr, uint8_t value) {
-    // Check for read-only registers
-    if (reg_addr <= 0x03) {
+    const RegDescriptor &desc = reg_table.entry[reg_addr];
+
+    if (desc.flags & REGF_READ_ONLY) {
         registers.error |= ERROR_INVALID_REG;
         return false;
     }
 
-    // Check for command register
-    if (reg_addr == REG_COMMAND) {
-        return i2c_execute_command(value);
+    // Data ports (command register, VU FIFO) live outside the bank store
+    if (desc.flags & REGF_NO_STORE) {
+        return desc.on_write(value);
     }
 
     // Bounds check
@@ -536,26 +2407,9 @@ bool i2c_register_write(uint8_t reg_addr, uint8_t value) {
     uint8_t *reg_ptr = (uint8_t*)&registers;
     reg_ptr[reg_addr] = value;
 
-    // Handle special control register operations
-    if (reg_addr == REG_CONTROL) {
-        if (value & CTRL_RESET_ENCODER) {
-            noInterrupts();
-            encoder_position = 0;
-            encoder_delta = 0;
-            interrupts();
-            registers.encoder_pos_low = 0;
-            registers.encoder_pos_high = 0;
-            registers.encoder_delta = 0;
-            // Clear the bit after action
-            registers.control &= ~CTRL_RESET_ENCODER;
-        }
-        if (value & CTRL_CLEAR_INPUTS) {
-            registers.input_changed_low = 0;
-            registers.input_changed_high = 0;
-            registers.status &= ~STATUS_INPUT_CHANGED;
-            // Clear the bit after action
-            registers.control &= ~CTRL_CLEAR_INPUTS;
-        }
+    // Post-store side effects (control register action bits)
+    if (desc.on_write) {
+        return desc.on_write(value);
     }
 
     return true;
@@ -567,8 +2421,42 @@ bool i2c_execute_command(uint8_t command) {
             break;
 
         case CMD_RESET:
-            // Soft reset
+            // Soft reset - cancel any running animation first so it does not
+            // restore stale register values over the re-initialized bank
+            anim_active = CMD_NOP;
             i2c_registers_init();
+            vu_fifo_tail = vu_fifo_head;
+            vu_fifo_assembly_idx = 0;
+            vu_fifo_hold_remaining = 0;
+            vu_pair_pending = false;
+            vu_pair_assembly_idx = 0;
+            event_fifo_tail = event_fifo_head;
+            event_fifo_byte_idx = 0;
+            break;
+
+        case CMD_FACTORY_RESET:
+            // Journal erase stalls XIP - defer to core0's idle loop, which
+            // also re-initializes the register bank to compiled defaults
+            config_factory_pending = true;
+            break;
+
+        case CMD_RESET_ODOMETER:
+            // Odometer is core1-owned; staged like the encoder reset
+            odometer_reset_pending = true;
+            break;
+
+        case CMD_BENCHMARK:
+            // Exercises GPIO/PWM paths, so core1 runs it on its next tick
+            registers.bench_status = BENCH_RUNNING;
+            bench_pending = true;
+            break;
+
+        case CMD_VU_FIFO_FLUSH:
+            // Discard queued frames and any partial frame in assembly
+            vu_fifo_tail = vu_fifo_head;
+            vu_fifo_assembly_idx = 0;
+            vu_fifo_hold_remaining = 0;
+            vu_fifo_refresh_regs();
             break;
 
         case CMD_TEST_VU_LEFT:
@@ -577,12 +2465,13 @@ bool i2c_execute_command(uint8_t command) {
         case CMD_TEST_BACKLIGHT:
         case CMD_TEST_TAPE_MOTOR:
         case CMD_TEST_ALL:
-            // Test commands - implement test patterns
-            // For now, just acknowledge
+            // Hand off to the animation engine; steps run on the 100Hz tick
+            anim_start(command);
             break;
 
         default:
             registers.error |= ERROR_INVALID_CMD;
+            log_msg(LOG_CAT_I2C, LOG_ERROR, "i2c: invalid command 0x%02X", command);
             return false;
     }
 
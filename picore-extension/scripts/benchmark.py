@@ -0,0 +1,115 @@
+#!/usr/bin/env python3
+"""
+I2C Benchmark for PiCorePlayer Music Streamer
+
+Regression benchmark to run before flashing a new firmware build. Two parts:
+
+1. Host-side: pushes maximum-rate I2C traffic (register writes, snapshot
+   block reads, VU FIFO bursts) and measures sustained transaction rates
+   from the Pi's side.
+2. Firmware-side: triggers CMD_BENCHMARK, which measures the register write
+   path and a full control cycle on the RP2040's own clock and reports loop
+   headroom.
+
+Usage:
+    python3 benchmark.py [--bus N] [--seconds S]
+"""
+
+import sys
+import time
+import argparse
+import logging
+from pathlib import Path
+
+try:
+    from rp2040_controller import RP2040Controller
+except ImportError:
+    sys.path.insert(0, str(Path(__file__).parent.parent / "src"))
+    from rp2040_controller import RP2040Controller
+
+# Configure logging
+logging.basicConfig(
+    level=logging.INFO,
+    format='%(asctime)s - %(name)s - %(levelname)s - %(message)s'
+)
+logger = logging.getLogger(__name__)
+
+
+def bench_register_writes(controller, seconds: float) -> float:
+    """Sustained single-register write transactions per second."""
+    count = 0
+    end = time.time() + seconds
+    while time.time() < end:
+        controller.set_vu_left(count & 0xFF)
+        count += 1
+    controller.set_vu_left(0)
+    return count / seconds
+
+
+def bench_snapshot_reads(controller, seconds: float) -> float:
+    """Sustained 12-byte snapshot block reads per second."""
+    count = 0
+    end = time.time() + seconds
+    while time.time() < end:
+        controller.get_snapshot()
+        count += 1
+    return count / seconds
+
+
+def bench_vu_frames(controller, seconds: float) -> float:
+    """Sustained VU FIFO frame throughput (frames per second)."""
+    frames = [(128, 128, 10)] * 8
+    count = 0
+    end = time.time() + seconds
+    while time.time() < end:
+        count += controller.queue_vu_frames(frames)
+        time.sleep(0.02)  # Let the firmware drain at its 100Hz rate
+    controller.flush_vu_fifo()
+    return count / seconds
+
+
+def main():
+    parser = argparse.ArgumentParser(description="RP2040 I2C benchmark")
+    parser.add_argument('--bus', type=int, default=1, help='I2C bus number')
+    parser.add_argument('--seconds', type=float, default=2.0,
+                        help='Duration of each host-side test')
+    args = parser.parse_args()
+
+    controller = RP2040Controller(bus=args.bus)
+    if not controller.open():
+        logger.error("Failed to open RP2040 controller")
+        return 1
+
+    try:
+        logger.info("Host-side bus throughput (%.1fs per test)...", args.seconds)
+        writes = bench_register_writes(controller, args.seconds)
+        snapshots = bench_snapshot_reads(controller, args.seconds)
+        frames = bench_vu_frames(controller, args.seconds)
+
+        logger.info("Firmware-side benchmark (CMD_BENCHMARK)...")
+        fw = controller.run_benchmark()
+        perf = controller.get_perf_counters()
+
+        print()
+        print("=== Host-side (bus) ===")
+        print(f"  Register writes:   {writes:8.0f} /s")
+        print(f"  Snapshot reads:    {snapshots:8.0f} /s")
+        print(f"  VU frames queued:  {frames:8.0f} /s")
+        print()
+        print("=== Firmware-side ===")
+        if fw is not None:
+            print(f"  Register write path: {fw['write_kops']} kops/s")
+            print(f"  Control cycle:       {fw['cycle_us']} us")
+            print(f"  Loop headroom:       {fw['headroom_pct']} %")
+        else:
+            print("  CMD_BENCHMARK timed out")
+        print(f"  Worst tick:          {perf['tick_max_us']} us")
+        print(f"  Worst jitter:        {perf['jitter_max_us']} us")
+        print(f"  Worst I2C handler:   {perf['i2c_max_us']} us")
+        return 0
+    finally:
+        controller.close()
+
+
+if __name__ == '__main__':
+    sys.exit(main())
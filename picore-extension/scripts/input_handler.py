@@ -198,63 +198,79 @@ class InputHandler:
             self.input_map[input_num] = (name, action)
             logger.info(f"Input {input_num} mapped to: {name}")
 
-    def handle_digital_inputs(self):
-        """Check and handle digital input changes."""
-        # Get inputs that have changed
-        changes = self.controller.get_input_changes()
-
-        # Get current input states
-        inputs = self.controller.get_digital_inputs()
-
-        # Process changed inputs
-        for i, changed in enumerate(changes, 1):
-            if changed and inputs[i - 1]:  # Input is pressed and changed
-                if i in self.input_map:
-                    name, action = self.input_map[i]
-                    logger.info(f"Input {i} ({name}) pressed")
-                    try:
-                        action()
-                    except Exception as e:
-                        logger.error(f"Error executing action for input {i}: {e}")
-
-    def handle_encoder(self):
-        """Handle rotary encoder rotation and button."""
-        # Get encoder delta
-        delta = self.controller.get_encoder_delta()
-
-        if delta != 0:
-            if self.encoder_volume_mode:
-                # Volume control mode
-                if delta > 0:
-                    SqueezeliteControl.volume_up(abs(delta))
-                else:
-                    SqueezeliteControl.volume_down(abs(delta))
+    def handle_input_press(self, input_num: int):
+        """
+        Execute the mapped action for a pressed input.
+
+        Args:
+            input_num: Input number (1-12)
+        """
+        if input_num in self.input_map:
+            name, action = self.input_map[input_num]
+            logger.info(f"Input {input_num} ({name}) pressed")
+            try:
+                action()
+            except Exception as e:
+                logger.error(f"Error executing action for input {input_num}: {e}")
+
+    def handle_encoder_delta(self, delta: int):
+        """
+        Handle encoder rotation.
+
+        Args:
+            delta: Signed encoder movement
+        """
+        if self.encoder_volume_mode:
+            # Volume control mode
+            if delta > 0:
+                SqueezeliteControl.volume_up(abs(delta))
             else:
-                # Track selection mode (not implemented)
-                logger.info(f"Encoder delta: {delta}")
+                SqueezeliteControl.volume_down(abs(delta))
+        else:
+            # Track selection mode (not implemented)
+            logger.info(f"Encoder delta: {delta}")
 
-        # Handle encoder button
-        button = self.controller.get_encoder_button()
+    def handle_button(self, state: int):
+        """
+        Handle an encoder button state transition.
 
-        if button == RP2040Controller.ENC_BTN_PRESSED:
+        Args:
+            state: New button state (ENC_BTN_*)
+        """
+        if state == RP2040Controller.ENC_BTN_PRESSED:
             logger.info("Encoder button pressed")
             SqueezeliteControl.play_pause()
-        elif button == RP2040Controller.ENC_BTN_HELD:
+        elif state == RP2040Controller.ENC_BTN_HELD:
             logger.info("Encoder button held")
             # Toggle encoder mode
             self.encoder_volume_mode = not self.encoder_volume_mode
             mode_str = "Volume" if self.encoder_volume_mode else "Track Selection"
             logger.info(f"Encoder mode: {mode_str}")
-        elif button == RP2040Controller.ENC_BTN_DOUBLE_CLICK:
+        elif state == RP2040Controller.ENC_BTN_DOUBLE_CLICK:
             logger.info("Encoder button double-clicked")
             SqueezeliteControl.mute_toggle()
 
-    def run(self, poll_rate: int = 20):
+    def handle_events(self):
+        """Drain the firmware event queue and dispatch each event."""
+        for event in self.controller.get_events():
+            etype = event['type']
+            if etype == RP2040Controller.EVENT_INPUT_PRESS:
+                self.handle_input_press(event['data'])
+            elif etype == RP2040Controller.EVENT_ENCODER_DELTA:
+                self.handle_encoder_delta(event['data'])
+            elif etype == RP2040Controller.EVENT_BUTTON:
+                self.handle_button(event['data'])
+            # EVENT_INPUT_RELEASE is ignored - actions fire on press
+
+    def run(self, poll_rate: int = 10):
         """
         Run the input handler main loop.
 
+        The firmware queues every edge with a timestamp, so a 10Hz poll
+        loses no events and keeps I2C traffic minimal.
+
         Args:
-            poll_rate: Polling rate in Hz (default: 20Hz)
+            poll_rate: Polling rate in Hz (default: 10Hz)
         """
         logger.info("Starting Input Handler")
         self.running = True
@@ -265,11 +281,8 @@ class InputHandler:
             while self.running:
                 start_time = time.time()
 
-                # Handle digital inputs
-                self.handle_digital_inputs()
-
-                # Handle encoder
-                self.handle_encoder()
+                # Drain and dispatch queued input/encoder events
+                self.handle_events()
 
                 # Sleep for remaining time to maintain poll rate
                 elapsed = time.time() - start_time
@@ -301,8 +314,8 @@ def main():
     parser.add_argument(
         "--poll-rate",
         type=int,
-        default=20,
-        help="Input polling rate in Hz (default: 20)"
+        default=10,
+        help="Input polling rate in Hz (default: 10)"
     )
     parser.add_argument(
         "--verbose",
@@ -3,7 +3,9 @@
 VU Meter Daemon for PiCorePlayer Music Streamer
 
 This daemon reads audio levels from ALSA and updates the RP2040-controlled
-VU meters with proper VU ballistics.
+VU meters. The ANSI ballistics (300ms time constant) run in firmware; the
+daemon streams raw block RMS levels and configures the firmware filters at
+startup via set_vu_ballistics().
 
 Based on the VU meter specifications from VUMeters.md:
 - Integration time: 300ms time constant
@@ -37,30 +39,26 @@ logger = logging.getLogger(__name__)
 
 class VUMeter:
     """
-    VU Meter ballistics implementation.
+    Raw RMS level detector.
 
-    Implements proper VU meter response with 300ms time constant.
+    Ballistics (the 300ms VU time constant) are applied by the RP2040
+    firmware's Q8.8 filters; smoothing the levels here as well would
+    double-filter the needles. This class only converts a sample block
+    to its instantaneous RMS level.
     """
 
-    def __init__(self, sample_rate: int = 44100, time_constant: float = 0.3):
+    def __init__(self, sample_rate: int = 44100):
         """
         Initialize VU meter.
 
         Args:
             sample_rate: Audio sample rate in Hz
-            time_constant: VU time constant in seconds (default: 0.3 = 300ms)
         """
         self.sample_rate = sample_rate
-        self.time_constant = time_constant
-
-        # Calculate smoothing factor for exponential smoothing
-        # alpha = 1 - exp(-1/(fs * tc))
-        self.alpha = 1.0 - math.exp(-1.0 / (sample_rate * time_constant))
-        self.vu_state = 0.0
 
     def process_samples(self, samples: list) -> float:
         """
-        Process audio samples and return RMS level with VU ballistics.
+        Process audio samples and return the block's raw RMS level.
 
         Args:
             samples: List of audio sample values
@@ -71,14 +69,9 @@ class VUMeter:
         if not samples:
             return 0.0
 
-        # Calculate instantaneous RMS power
+        # Instantaneous RMS power - firmware ballistics do the smoothing
         power = sum(s * s for s in samples) / len(samples)
-
-        # Apply VU ballistics (exponential smoothing)
-        self.vu_state = self.alpha * power + (1.0 - self.alpha) * self.vu_state
-
-        # Return RMS value
-        return math.sqrt(max(0.0, self.vu_state))
+        return math.sqrt(max(0.0, power))
 
 
 class VUMeterDaemon:
@@ -130,9 +123,11 @@ class VUMeterDaemon:
         version = self.controller.get_firmware_version()
         logger.info(f"RP2040 firmware version: {version[0]}.{version[1]}.{version[2]}")
 
-        # Enable VU meters
+        # Enable VU meters; ballistics run in firmware, so configure the
+        # ANSI 300ms time constant explicitly and stream raw levels
         self.controller.enable_vu_meters(True)
         self.controller.set_vu_mode(RP2040Controller.VU_MODE_NORMAL)
+        self.controller.set_vu_ballistics(300, 300)
 
         self.running = True
         logger.info("VU Meter Daemon started")
@@ -52,6 +52,7 @@ class RP2040Controller:
     REG_TAPE_SPEED = 0x40
     REG_TAPE_DIRECTION = 0x41
     REG_TAPE_MODE = 0x42
+    REG_TAPE_ODO = 0x43
 
     # Digital Input Registers
     REG_INPUT_STATUS_LOW = 0x50
@@ -69,6 +70,63 @@ class RP2040Controller:
     REG_CONFIG_VU_FREQ = 0x70
     REG_CONFIG_DEBOUNCE = 0x71
     REG_CONFIG_OPTIONS = 0x72
+    REG_CONFIG_VU_ATTACK = 0x73
+    REG_CONFIG_VU_RELEASE = 0x74
+    REG_CONFIG_PEAK_HOLD = 0x75
+    REG_CONFIG_PEAK_DECAY = 0x76
+    REG_CONFIG_VU_SLEW = 0x77
+    REG_CONFIG_TAPE_ACCEL = 0x78
+    REG_CONFIG_LOG_LEVEL = 0x79
+    REG_CONFIG_IDLE_TIMEOUT = 0x7A
+    REG_CONFIG_IDLE_LEVEL = 0x7B
+    REG_CONFIG_HOST_TIMEOUT = 0x7C
+
+    # Serial log categories and levels (REG_CONFIG_LOG_LEVEL, 2 bits each)
+    LOG_CAT_SYS = 0
+    LOG_CAT_I2C = 1
+    LOG_CAT_CTRL = 2
+    LOG_CAT_CONFIG = 3
+    LOG_OFF = 0
+    LOG_ERROR = 1
+    LOG_INFO = 2
+    LOG_DEBUG = 3
+
+    # State Snapshot Registers (latched once per firmware update tick)
+    REG_SNAPSHOT_BASE = 0x80
+    SNAPSHOT_SIZE = 16
+
+    # VU Sample FIFO Registers (firmware-timed playback)
+    REG_VU_FIFO_DATA = 0xA0
+    REG_VU_FIFO_COUNT = 0xA1
+    REG_VU_FIFO_SPACE = 0xA2
+    REG_VU_PAIR_DATA = 0xA3
+    VU_FIFO_DEPTH = 32
+
+    # Performance Counter Registers
+    REG_PERF_BASE = 0xB0
+    PERF_SIZE = 10
+
+    # Benchmark result block (written by CMD_BENCHMARK)
+    REG_BENCH_BASE = 0xBA
+    BENCH_SIZE = 6
+    BENCH_IDLE = 0x00
+    BENCH_RUNNING = 0x01
+    BENCH_DONE = 0x02
+
+    # Input/Encoder Event Queue Registers
+    REG_EVENT_FIFO_DATA = 0xA8
+    REG_EVENT_FIFO_COUNT = 0xA9
+    EVENT_SIZE = 4
+
+    # Animation Engine Status Register
+    REG_ANIM_ACTIVE = 0xAA
+
+    # Event Types
+    EVENT_NONE = 0x00
+    EVENT_INPUT_PRESS = 0x01
+    EVENT_INPUT_RELEASE = 0x02
+    EVENT_ENCODER_DELTA = 0x03
+    EVENT_BUTTON = 0x04
 
     # Command Register
     REG_COMMAND = 0xF0
@@ -93,6 +151,15 @@ class RP2040Controller:
     STATUS_ENCODER_CHANGED = 0x40
     STATUS_BUTTON_PRESSED = 0x80
 
+    # Error register bits
+    ERROR_I2C_OVERFLOW = 0x01
+    ERROR_INVALID_REG = 0x02
+    ERROR_INVALID_CMD = 0x04
+    ERROR_PWM_FAULT = 0x08
+    ERROR_WATCHDOG = 0x10
+    ERROR_EVENT_OVERFLOW = 0x20
+    ERROR_HOST_TIMEOUT = 0x40
+
     # VU Modes
     VU_MODE_NORMAL = 0x00
     VU_MODE_PEAK_HOLD = 0x01
@@ -126,11 +193,14 @@ class RP2040Controller:
     CMD_NOP = 0x00
     CMD_RESET = 0x01
     CMD_FACTORY_RESET = 0x02
+    CMD_BENCHMARK = 0x40
     CMD_TEST_VU_LEFT = 0x11
     CMD_TEST_VU_RIGHT = 0x12
     CMD_TEST_VU_BOTH = 0x13
+    CMD_VU_FIFO_FLUSH = 0x14
     CMD_TEST_BACKLIGHT = 0x20
     CMD_TEST_TAPE_MOTOR = 0x30
+    CMD_RESET_ODOMETER = 0x31
     CMD_TEST_ALL = 0xFF
 
     def __init__(self, bus: int = DEFAULT_BUS, address: int = DEFAULT_ADDRESS):
@@ -273,14 +343,17 @@ class RP2040Controller:
 
     def set_vu_meters(self, left: int, right: int):
         """
-        Set both VU meter levels.
+        Set both VU meter levels in one I2C transaction.
+
+        Uses the paired write port (0xA3) so the firmware latches both
+        channels on the same control tick - no inter-channel skew.
 
         Args:
             left: Left VU level (0-255)
             right: Right VU level (0-255)
         """
-        self.set_vu_left(left)
-        self.set_vu_right(right)
+        self.bus.write_i2c_block_data(self.address, self.REG_VU_PAIR_DATA,
+                                      [left & 0xFF, right & 0xFF])
 
     def set_vu_mode(self, mode: int):
         """
@@ -291,6 +364,93 @@ class RP2040Controller:
         """
         self.write_register(self.REG_VU_MODE, mode)
 
+    def set_vu_ballistics(self, attack_ms: int = 300, release_ms: int = 300):
+        """
+        Set firmware VU ballistics time constants.
+
+        The firmware runs ANSI-style attack/release filters at 100Hz, so the
+        host only needs to stream raw peak levels at 10-20Hz.
+
+        Args:
+            attack_ms: Time to reach 99% of a rising step in ms (0=instant,
+                       resolution 10ms, max 2550ms). Default 300ms per ANSI C16.5.
+            release_ms: Time to decay 99% of a falling step in ms (same units)
+        """
+        self.write_register(self.REG_CONFIG_VU_ATTACK, min(255, attack_ms // 10))
+        self.write_register(self.REG_CONFIG_VU_RELEASE, min(255, release_ms // 10))
+
+    def set_vu_peak_hold(self, hold_ms: int = 1000, decay: int = 4):
+        """
+        Configure peak-hold behavior for VU_MODE_PEAK_HOLD.
+
+        In peak-hold mode the firmware latches each channel at its peak,
+        holds it, then decays it at the tick rate - no host involvement.
+
+        Args:
+            hold_ms: Time the peak is held in ms (resolution 10ms, max 2550ms)
+            decay: Fall rate after the hold, in counts per 10ms tick (1-255)
+        """
+        self.write_register(self.REG_CONFIG_PEAK_HOLD, min(255, hold_ms // 10))
+        self.write_register(self.REG_CONFIG_PEAK_DECAY, min(255, max(1, decay)))
+
+    def set_vu_slew(self, rate: int = 16):
+        """
+        Set the firmware VU slew limit.
+
+        The firmware ramps the needle PWM toward the current level at 1kHz,
+        bounded by this rate, so a 30-50Hz host stream still produces
+        continuous needle motion.
+
+        Args:
+            rate: Maximum travel per 1ms, in 1/4 count units (16 = 4
+                  counts/ms = full scale in 64ms). 0 disables slew limiting.
+        """
+        self.write_register(self.REG_CONFIG_VU_SLEW, min(255, max(0, rate)))
+
+    def queue_vu_frames(self, frames: List[Tuple[int, int, int]]) -> int:
+        """
+        Burst VU frames into the firmware playback FIFO.
+
+        Each frame is (left, right, hold_ms); the firmware applies the frame
+        and waits hold_ms on its own clock before applying the next one, so
+        needle timing is immune to host scheduling jitter. The host can batch
+        ~100ms of frames per call instead of writing levels at 100Hz.
+
+        Args:
+            frames: List of (left, right, hold_ms) tuples, each value 0-255
+
+        Returns:
+            Number of frames actually queued (limited by FIFO free space)
+        """
+        space = self.read_register(self.REG_VU_FIFO_SPACE)
+        frames = frames[:space]
+
+        # SMBus block writes carry at most 32 bytes, i.e. 10 whole frames
+        for start in range(0, len(frames), 10):
+            data = []
+            for left, right, hold_ms in frames[start:start + 10]:
+                data += [left & 0xFF, right & 0xFF, hold_ms & 0xFF]
+            try:
+                self.bus.write_i2c_block_data(self.address, self.REG_VU_FIFO_DATA, data)
+            except Exception as e:
+                logger.error(f"Failed to queue VU frames: {e}")
+                raise
+
+        return len(frames)
+
+    def get_vu_fifo_space(self) -> int:
+        """
+        Read the number of free frame slots in the VU playback FIFO.
+
+        Returns:
+            Free frame slots (0-31)
+        """
+        return self.read_register(self.REG_VU_FIFO_SPACE)
+
+    def flush_vu_fifo(self):
+        """Discard all queued VU playback frames."""
+        self.send_command(self.CMD_VU_FIFO_FLUSH)
+
     def enable_vu_meters(self, enable: bool = True):
         """
         Enable or disable VU meters.
@@ -327,6 +487,42 @@ class RP2040Controller:
         """
         self.write_register(self.REG_BACKLIGHT_MODE, mode)
 
+    def set_idle_dimming(self, timeout_s: int = 30, level: int = 0):
+        """
+        Configure firmware backlight idle dimming.
+
+        After timeout_s seconds with no input, encoder or button activity
+        the firmware fades the backlight down to level; the first user
+        action restores full brightness within one 10ms tick. Replaces
+        the host-side idle watcher, so an idle system makes no I2C
+        traffic at all.
+
+        Args:
+            timeout_s: Inactivity timeout in seconds (0 disables the engine)
+            level: Backlight brightness while dimmed (0-255)
+        """
+        self.write_register(self.REG_CONFIG_IDLE_TIMEOUT,
+                            min(255, max(0, timeout_s)))
+        self.write_register(self.REG_CONFIG_IDLE_LEVEL,
+                            min(255, max(0, level)))
+
+    def set_host_timeout(self, timeout_s: float = 2.0):
+        """
+        Configure the firmware host-liveness failsafe.
+
+        If this process stops talking (crash, hang, reboot) for longer
+        than the window, the firmware parks the outputs: VU needles glide
+        to zero and the tape motor ramps to a stop. ERROR_HOST_TIMEOUT
+        latches in the error register to record the outage. Any I2C
+        transaction resumes normal operation within one 10ms tick.
+
+        Args:
+            timeout_s: Silence window in seconds, 0.1-25.5 resolution
+                       0.1s. 0 disables the failsafe.
+        """
+        self.write_register(self.REG_CONFIG_HOST_TIMEOUT,
+                            min(255, max(0, int(round(timeout_s * 10)))))
+
     def enable_backlight(self, enable: bool = True):
         """
         Enable or disable backlight.
@@ -367,6 +563,63 @@ class RP2040Controller:
         direction = self.TAPE_DIR_BRAKE if brake else self.TAPE_DIR_STOP
         self.write_register(self.REG_TAPE_DIRECTION, direction)
 
+    def set_tape_accel(self, accel: int = 8):
+        """
+        Set the firmware tape motor ramp rate.
+
+        Speed and direction writes are targets; the firmware ramps the
+        H-bridge drive toward them at this rate, ramping down through zero
+        before any direction change or brake. One write per transition
+        replaces the host-side ramp loop.
+
+        Args:
+            accel: Speed change per 10ms tick (8 = 0 to full in ~320ms).
+                   0 applies writes instantly (no ramping).
+        """
+        self.write_register(self.REG_CONFIG_TAPE_ACCEL, min(255, max(0, accel)))
+
+    def set_log_levels(self, sys: int = 2, i2c: int = 2,
+                       ctrl: int = 2, config: int = 2):
+        """
+        Set the firmware serial log verbosity per category.
+
+        Messages only appear (and only cost anything) while a USB console
+        is attached to the RP2040, so DEBUG can be left on in the field.
+
+        Args:
+            sys: System category level (0=off, 1=error, 2=info, 3=debug)
+            i2c: I2C protocol category level
+            ctrl: Control loop / animation category level
+            config: Flash config journal category level
+        """
+        packed = ((sys & 0x3) << (self.LOG_CAT_SYS * 2) |
+                  (i2c & 0x3) << (self.LOG_CAT_I2C * 2) |
+                  (ctrl & 0x3) << (self.LOG_CAT_CTRL * 2) |
+                  (config & 0x3) << (self.LOG_CAT_CONFIG * 2))
+        self.write_register(self.REG_CONFIG_LOG_LEVEL, packed)
+
+    def get_tape_odometer(self) -> int:
+        """
+        Read the firmware-maintained virtual tape counter.
+
+        The firmware integrates the actual (ramped) drive speed at its
+        100Hz tick, so the count does not drift when this process misses
+        scheduling deadlines. One count is one speed unit for 10ms; full
+        speed forward accumulates 25,500 counts per second.
+
+        Returns:
+            Signed odometer value (reverse drive decrements)
+        """
+        data = self.bus.read_i2c_block_data(self.address, self.REG_TAPE_ODO, 4)
+        odo = (data[3] << 24) | (data[2] << 16) | (data[1] << 8) | data[0]
+        if odo > 0x7FFFFFFF:
+            odo -= 0x100000000
+        return odo
+
+    def reset_odometer(self):
+        """Zero the virtual tape counter (e.g. on tape change)."""
+        self.send_command(self.CMD_RESET_ODOMETER)
+
     def enable_tape_motor(self, enable: bool = True):
         """
         Enable or disable tape motor.
@@ -440,10 +693,12 @@ class RP2040Controller:
         Returns:
             16-bit signed encoder position (-32768 to 32767)
         """
-        low = self.read_register(self.REG_ENCODER_POS_LOW)
-        high = self.read_register(self.REG_ENCODER_POS_HIGH)
+        # Single transaction: the firmware latches the encoder block when
+        # the read is staged, so the two bytes can never tear
+        data = self.bus.read_i2c_block_data(
+            self.address, self.REG_ENCODER_POS_LOW, 2)
 
-        pos = (high << 8) | low
+        pos = (data[1] << 8) | data[0]
         # Convert to signed 16-bit
         if pos > 32767:
             pos -= 65536
@@ -480,6 +735,206 @@ class RP2040Controller:
         control = self.read_register(self.REG_CONTROL)
         self.write_register(self.REG_CONTROL, control | self.CTRL_RESET_ENCODER)
 
+    # ========================================================================
+    # Config Persistence
+    # ========================================================================
+
+    def save_config(self, timeout: float = 1.0) -> bool:
+        """
+        Persist the config registers (0x70-0x7F) to the RP2040's flash.
+
+        The firmware defers the flash write to its idle loop and clears
+        SAVE_CONFIG when it completes; this polls for that.
+
+        Args:
+            timeout: Seconds to wait for the save to complete
+
+        Returns:
+            True if the save completed within the timeout
+        """
+        control = self.read_register(self.REG_CONTROL)
+        self.write_register(self.REG_CONTROL, control | self.CTRL_SAVE_CONFIG)
+
+        deadline = time.time() + timeout
+        while time.time() < deadline:
+            if not self.read_register(self.REG_CONTROL) & self.CTRL_SAVE_CONFIG:
+                return True
+            time.sleep(0.01)
+        return False
+
+    def load_config(self):
+        """Reload the persisted config registers from flash."""
+        control = self.read_register(self.REG_CONTROL)
+        self.write_register(self.REG_CONTROL, control | self.CTRL_LOAD_CONFIG)
+
+    def factory_reset(self):
+        """Erase the persisted config and restore firmware defaults."""
+        self.send_command(self.CMD_FACTORY_RESET)
+
+    # ========================================================================
+    # Performance Counters
+    # ========================================================================
+
+    def get_perf_counters(self) -> dict:
+        """
+        Read the firmware performance counter block.
+
+        Returns:
+            Dictionary with microsecond timings: tick_us, tick_max_us,
+            jitter_us, jitter_max_us, i2c_us, i2c_max_us
+
+        Note: Reading this block rearms the MAX latches.
+        """
+        data = self.bus.read_i2c_block_data(
+            self.address, self.REG_PERF_BASE, self.PERF_SIZE)
+        return {
+            'tick_us': data[0] | (data[1] << 8),
+            'tick_max_us': data[2] | (data[3] << 8),
+            'jitter_us': data[4] | (data[5] << 8),
+            'jitter_max_us': data[6] | (data[7] << 8),
+            'i2c_us': data[8],
+            'i2c_max_us': data[9],
+        }
+
+    def run_benchmark(self, timeout: float = 1.0) -> Optional[dict]:
+        """
+        Run the firmware's internal benchmark and collect the results.
+
+        The firmware measures its register write path and a full control
+        cycle on its own clock; this triggers the run and polls the result
+        block.
+
+        Args:
+            timeout: Seconds to wait for the benchmark to complete
+
+        Returns:
+            Dictionary with write_kops (register writes per second / 1000),
+            cycle_us (one control cycle in microseconds) and headroom_pct
+            (tick budget left), or None on timeout
+        """
+        self.send_command(self.CMD_BENCHMARK)
+
+        deadline = time.time() + timeout
+        while time.time() < deadline:
+            data = self.bus.read_i2c_block_data(
+                self.address, self.REG_BENCH_BASE, self.BENCH_SIZE)
+            if data[5] == self.BENCH_DONE:
+                return {
+                    'write_kops': data[0] | (data[1] << 8),
+                    'cycle_us': data[2] | (data[3] << 8),
+                    'headroom_pct': data[4],
+                }
+            time.sleep(0.01)
+        return None
+
+    # ========================================================================
+    # Event Queue
+    # ========================================================================
+
+    def get_events(self) -> List[dict]:
+        """
+        Drain the firmware input/encoder event queue.
+
+        Every input edge, encoder movement and button transition is queued
+        with a firmware-side millisecond timestamp, so no edge is lost even
+        at low polling rates (10Hz is sufficient).
+
+        Returns:
+            List of event dictionaries with keys:
+            - type: EVENT_INPUT_PRESS, EVENT_INPUT_RELEASE,
+                    EVENT_ENCODER_DELTA or EVENT_BUTTON
+            - data: input number (1-12), signed encoder delta,
+                    or new button state depending on type
+            - timestamp: firmware millis() at event time (16-bit, wraps)
+        """
+        count = self.read_register(self.REG_EVENT_FIFO_COUNT)
+        events = []
+
+        while count > 0:
+            # SMBus block reads carry at most 32 bytes, i.e. 8 whole events
+            batch = min(count, 8)
+            try:
+                data = self.bus.read_i2c_block_data(
+                    self.address, self.REG_EVENT_FIFO_DATA, batch * self.EVENT_SIZE)
+            except Exception as e:
+                logger.error(f"Failed to read event queue: {e}")
+                raise
+
+            for i in range(batch):
+                etype, edata, ts_low, ts_high = data[i * 4:i * 4 + 4]
+                if etype == self.EVENT_NONE:
+                    continue
+                if etype == self.EVENT_ENCODER_DELTA and edata > 127:
+                    edata -= 256
+                events.append({
+                    'type': etype,
+                    'data': edata,
+                    'timestamp': (ts_high << 8) | ts_low,
+                })
+            count -= batch
+
+        return events
+
+    # ========================================================================
+    # State Snapshot
+    # ========================================================================
+
+    def get_snapshot(self) -> dict:
+        """
+        Read the full machine state in a single I2C block transaction.
+
+        The firmware latches the snapshot block atomically once per update
+        tick, so all fields are guaranteed coherent with each other.
+
+        Returns:
+            Dictionary with keys: status, error, inputs (list of 12 bools,
+            True = pressed), changed (list of 12 bools), encoder_position,
+            encoder_delta, encoder_button, tick, tape_odometer
+
+        Note: Reading the snapshot clears the input changed flags and the
+        encoder changed status, same as reading the live registers.
+        """
+        try:
+            data = self.bus.read_i2c_block_data(
+                self.address, self.REG_SNAPSHOT_BASE, self.SNAPSHOT_SIZE)
+        except Exception as e:
+            logger.error(f"Failed to read snapshot block: {e}")
+            raise
+
+        status, error = data[0], data[1]
+        status_low, status_high = data[2], data[3]
+        changed_low, changed_high = data[4], data[5]
+
+        # Inputs are active low, so invert the logic
+        inputs = [(status_low & (1 << i)) == 0 for i in range(8)]
+        inputs += [(status_high & (1 << i)) == 0 for i in range(4)]
+        changed = [(changed_low & (1 << i)) != 0 for i in range(8)]
+        changed += [(changed_high & (1 << i)) != 0 for i in range(4)]
+
+        pos = (data[7] << 8) | data[6]
+        if pos > 32767:
+            pos -= 65536
+
+        delta = data[8]
+        if delta > 127:
+            delta -= 256
+
+        odo = (data[15] << 24) | (data[14] << 16) | (data[13] << 8) | data[12]
+        if odo > 0x7FFFFFFF:
+            odo -= 0x100000000
+
+        return {
+            'status': status,
+            'error': error,
+            'inputs': inputs,
+            'changed': changed,
+            'encoder_position': pos,
+            'encoder_delta': delta,
+            'encoder_button': data[9],
+            'tick': (data[11] << 8) | data[10],
+            'tape_odometer': odo,
+        }
+
     # ========================================================================
     # Commands
     # ========================================================================
@@ -520,6 +975,32 @@ class RP2040Controller:
         """Test all outputs."""
         self.send_command(self.CMD_TEST_ALL)
 
+    def is_test_running(self) -> bool:
+        """
+        Check whether a CMD_TEST_* pattern is still animating.
+
+        Returns:
+            True while the animation engine is busy, False when idle
+        """
+        return self.read_register(self.REG_ANIM_ACTIVE) != 0x00
+
+    def wait_for_test(self, timeout: float = 5.0) -> bool:
+        """
+        Block until the running test pattern completes.
+
+        Args:
+            timeout: Maximum time to wait in seconds
+
+        Returns:
+            True if the pattern finished, False on timeout
+        """
+        deadline = time.time() + timeout
+        while time.time() < deadline:
+            if not self.is_test_running():
+                return True
+            time.sleep(0.05)
+        return False
+
 
 # Example usage
 if __name__ == "__main__":